@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Defines.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// bit scans. the mask must be non-zero
+inline uint32 bit_scan_forward(uint32 mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (uint32)index;
+#else
+    return (uint32)__builtin_ctz(mask);
+#endif
+}
+inline uint32 bit_scan_reverse(uint32 mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (uint32)index;
+#else
+    return 31 - (uint32)__builtin_clz(mask);
+#endif
+}
+inline uint32 bit_scan_forward64(uint64 mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (uint32)index;
+#else
+    return (uint32)__builtin_ctzll(mask);
+#endif
+}
+inline uint32 bit_scan_reverse64(uint64 mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, mask);
+    return (uint32)index;
+#else
+    return 63 - (uint32)__builtin_clzll(mask);
+#endif
+}
@@ -1,8 +1,12 @@
 #include "Event.h"
 
 #include "Core/Logger.h"
+#include "Core/Logger_Limit.h"
+#include "Core/Logger_Binary.h"
 #include "Core/Asserts.h"
 #include "Memory/Memory_Arena.h"
+#include "Memory/Memory.h"
+#include "Core/Event_Trace.h"
 
 struct registered_event {
     void* listener;
@@ -11,6 +15,7 @@ struct registered_event {
 
 #define MAX_MESSAGE_CODES 512
 #define MAX_LISTENERS 256
+#define EVENT_FRAME_ARENA_SIZE Megabytes(1)
 
 struct event_code_entry {
     uint16 num_listeners;
@@ -19,7 +24,7 @@ struct event_code_entry {
 
 struct event_system_state {
     memory_arena* engine_arena;
-    //memory_arena event_queue;
+    memory_arena frame_arena; // payloads, reset every frame
 
     uint16 num_codes;
     event_code_entry* registered;
@@ -42,6 +47,7 @@ bool32 event_init(memory_arena* arena) {
         global_event_state->registered[n].events = PushArray(arena, registered_event, MAX_LISTENERS);
         global_event_state->registered[n].num_listeners = 0;
     }
+    global_event_state->frame_arena = CreateSubArena(arena, EVENT_FRAME_ARENA_SIZE);
 
     is_initialized = true;
     return true;
@@ -66,7 +72,7 @@ bool32 event_register(uint16 code, void* listener, on_event_func on_event) {
     for (uint16 n = 0; n < event_entry->num_listeners; n++) {
         registered_event* event = &event_entry->events[n];
         if (event->listener == listener) {
-            RH_WARN("Tried to register the same listener on event code %d twice!", code);
+            RH_LOG_DEDUP(LOG_CHANNEL_EVENTS, LOG_LEVEL_WARN, "Tried to register the same listener on event code %d twice!", code);
             return false;
         }
     }
@@ -84,7 +90,7 @@ bool32 event_unregister(uint16 code, void* listener, on_event_func on_event) {
 
     event_code_entry* event_entry = &global_event_state->registered[code];
     if (event_entry->num_listeners == 0) {
-        RH_WARN("No listeners registered on event code %d; cannot unregister.", code);
+        RH_LOG_DEDUP(LOG_CHANNEL_EVENTS, LOG_LEVEL_WARN, "No listeners registered on event code %d; cannot unregister.", code);
         return false;
     }
 
@@ -103,11 +109,16 @@ bool32 event_unregister(uint16 code, void* listener, on_event_func on_event) {
         }
     }
 
-    RH_WARN("Could not find this listener on event code %d!", code);
+    RH_LOG_DEDUP(LOG_CHANNEL_EVENTS, LOG_LEVEL_WARN, "Could not find this listener on event code %d!", code);
     return false;
 }
 
 bool32 event_fire(uint16 code, void* sender, event_context context) {
+    event_trace_record(code, sender, context, nullptr);
+    return event_fire_listeners(code, sender, context);
+}
+
+bool32 event_fire_listeners(uint16 code, void* sender, event_context context) {
     if (!is_initialized) {
         return false;
     }
@@ -115,19 +126,78 @@ bool32 event_fire(uint16 code, void* sender, event_context context) {
     event_code_entry* event_entry = &global_event_state->registered[code];
     if (event_entry->num_listeners == 0) {
         // no listeners on this event
-        //RH_TRACE("Firing event code %d to no listeners", code);
+        RH_TRACE_BIN_CH(LOG_CHANNEL_EVENTS, "Firing event code %d to no listeners", code);
         return false;
     }
 
     for (uint16 n = 0; n < event_entry->num_listeners; n++) {
         registered_event* event = &event_entry->events[n];
         AssertMsg(event->callback, "Event callback is NULL");
-        //RH_TRACE("Firing event code %d to listener %d", code, n);
+        RH_TRACE_BIN_CH(LOG_CHANNEL_EVENTS, "Firing event code %d to listener %d", code, n);
         if (event->callback(code, sender, event->listener, context)) {
             return true; // callback is handled, stop propogating this message
         }
     }
 
-    //RH_WARN("Failed to fire event code %d for some reason!", code);
+    //RH_WARN_CH(LOG_CHANNEL_EVENTS, "Failed to fire event code %d for some reason!", code);
     return false;
+}
+
+bool32 event_has_listeners(uint16 code) {
+    if (!is_initialized) {
+        return false;
+    }
+    return global_event_state->registered[code].num_listeners > 0;
+}
+
+event_payload* event_alloc_payload(uint64 size) {
+    if (!is_initialized) {
+        return nullptr;
+    }
+
+    // keep the next payload 8-byte aligned
+    uint64 total_size = (sizeof(event_payload) + size + 7) & ~((uint64)7);
+
+    memory_arena* arena = &global_event_state->frame_arena;
+    if (arena->Used + total_size > arena->Size) {
+        RH_LOG_RATE(LOG_CHANNEL_EVENTS, LOG_LEVEL_WARN, 1, "Event frame arena is full, dropping %llu byte payload!", size);
+        return nullptr;
+    }
+
+    event_payload* payload = (event_payload*)PushSize_(arena, total_size);
+    payload->size = size;
+    payload->data = (uint8*)(payload + 1);
+
+    return payload;
+}
+
+bool32 event_fire_payload(uint16 code, void* sender, const void* data, uint64 size) {
+    event_payload* payload = event_alloc_payload(size);
+    if (!payload) {
+        return false;
+    }
+    memory_copy(payload->data, data, size);
+
+    return event_fire_payload(code, sender, payload);
+}
+
+bool32 event_fire_payload(uint16 code, void* sender, event_payload* payload) {
+    event_context context;
+    context.ptr = payload;
+
+    event_trace_record(code, sender, context, payload);
+    return event_fire_listeners(code, sender, context);
+}
+
+const event_payload* event_get_payload(event_context context) {
+    return (const event_payload*)context.ptr;
+}
+
+void event_end_frame() {
+    if (!is_initialized) {
+        return;
+    }
+
+    ResetArena(&global_event_state->frame_arena);
+    event_trace_end_frame();
 }
\ No newline at end of file
@@ -3,27 +3,7 @@
 #include "Defines.h"
 
 struct event_context {
-#if 0
-    // 128 bytes
-    union {
-        int64  i64[2];
-        uint64 u64[2];
-        real64 f64[2];
-
-        int32  i32[4];
-        uint32 u32[4];
-        real32 f32[4];
-
-        int16  i16[8];
-        uint16 u16[8];
-
-        int8   i8[16];
-        uint8  u8[16];
-
-        char   c[16];
-    };
-#else
-    // 64 bytes
+    // 8 bytes
     union {
         int64  i64;
         uint64 u64;
@@ -40,8 +20,20 @@ struct event_context {
         uint8  u8[8];
 
         char   c[8];
+
+        // points at an event_payload, for events that don't fit in 8 bytes
+        void*  ptr;
     };
-#endif
+};
+
+/* 
+ * Event data larger than 8 bytes is copied into the event frame arena, and
+ * context.ptr points at it. A payload is only valid until event_end_frame(),
+ * so listeners have to copy anything they want to keep.
+ * */
+struct event_payload {
+    uint64 size;
+    uint8* data;
 };
 
 // callback should return true if handled. (i.e. don't propoagte the message anymore)
@@ -54,6 +46,21 @@ RHAPI bool32 event_register(uint16 code, void* listener, on_event_func on_event)
 RHAPI bool32 event_unregister(uint16 code, void* listener, on_event_func on_event);
 
 RHAPI bool32 event_fire(uint16 code, void* sender, event_context context);
+// same as event_fire, but never written to the event trace.
+// used by typed events and trace replay, which record/replay on their own.
+RHAPI bool32 event_fire_listeners(uint16 code, void* sender, event_context context);
+// true if anything is registered at runtime on code
+RHAPI bool32 event_has_listeners(uint16 code);
+
+// copies data into the frame arena and fires the event with context.ptr pointing to it
+RHAPI bool32 event_fire_payload(uint16 code, void* sender, const void* data, uint64 size);
+// fires a payload already filled in from event_alloc_payload()
+RHAPI bool32 event_fire_payload(uint16 code, void* sender, event_payload* payload);
+RHAPI event_payload* event_alloc_payload(uint64 size);
+RHAPI const event_payload* event_get_payload(event_context context);
+
+// releases all payloads fired this frame
+void event_end_frame();
 
 enum system_event_code {
     // shut down app on the next frame
@@ -61,27 +68,42 @@ enum system_event_code {
 
     /* Context usage: 
      * key_code in u16[0];
+     * modifiers in u16[1]; (key_modifiers flags)
      * */
     EVENT_CODE_KEY_PRESSED = 0x02,
     EVENT_CODE_KEY_RELEASED = 0x03,
+    /* Context usage: 
+     * button in u16[0];
+     * (the mouse position is only on the typed events)
+     * */
     EVENT_CODE_BUTTON_PRESSED = 0x04,
     EVENT_CODE_BUTTON_RELEASED = 0x05,
 
     /* Context usage: 
-     * mouse_x in u16[0];
-     * mouse_y in u16[1];
+     * mouse_x in i32[0];
+     * mouse_y in i32[1];
      * */
     EVENT_CODE_MOUSE_MOVED = 0x06,
     /* Context usage: 
-     * z_delta in u8[0];
+     * z_delta in i32[0];
      * */
     EVENT_CODE_MOUSE_WHEEL = 0x07,
 
     /* Context usage: 
-     * width in  u16[0];
-     * height in u16[1];
+     * width in  u32[0];
+     * height in u32[1];
      * */
     EVENT_CODE_RESIZED = 0x08,
 
+    /* Context usage: 
+     * event_get_payload(context) -> null-terminated file path
+     * */
+    EVENT_CODE_FILE_DROPPED = 0x09,
+
+    /* Context usage: 
+     * action id in u32[0]; (input_find_action)
+     * */
+    EVENT_CODE_ACTION_PRESSED = 0x0A,
+
     MAX_EVENT_CODE = 0xFF
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Core/Event_Typed.h"
+
+/*
+ * Static listener tables for typed events.
+ * Include this (not Event_Typed.h) from anywhere that calls event_dispatch(),
+ * so every translation unit sees the same table for each event.
+ * */
+
+// engine listeners, defined in main.cpp
+bool32 engine_on_quit(const event_application_quit& event);
+bool32 engine_on_resized(const event_resized& event);
+bool32 engine_on_action(const event_action_pressed& event);
+
+RH_EVENT_LISTENERS(event_application_quit, engine_on_quit);
+RH_EVENT_LISTENERS(event_resized,          engine_on_resized);
+RH_EVENT_LISTENERS(event_action_pressed,   engine_on_action);
@@ -0,0 +1,267 @@
+#include "Event_Trace.h"
+
+#include "Core/Logger.h"
+#include "Core/Asserts.h"
+#include "Core/Event_Listeners.h"
+#include "Memory/Memory.h"
+#include "Platform/Platform.h"
+
+#define EVENT_TRACE_MAGIC   0x56454852 // 'RHEV'
+#define EVENT_TRACE_VERSION 1
+
+struct event_trace_header {
+    uint32 magic;
+    uint32 version;
+    uint64 num_entries;
+};
+
+// 32 bytes. payload bytes (if any) follow, padded out to 8 bytes.
+struct event_trace_entry {
+    int64  timestamp; // wall clock ticks since recording started
+    uint64 sender;
+    uint64 context;
+    uint32 frame;
+    uint16 code;
+    uint16 payload_size;
+};
+
+#define EVENT_TRACE_ALIGN(size) (((size) + 7) & ~((uint64)7))
+
+struct event_trace_state {
+    bool32 recording;
+    bool32 replaying;
+    uint32 frame_index;
+    int64  start_clock;
+
+    // recording
+    uint8* buffer;
+    uint64 buffer_size;
+    uint64 buffer_used;
+    uint64 num_entries;
+    bool32 overflowed;
+
+    // replay
+    mapped_file replay_file;
+    uint8* replay_scan;
+    uint8* replay_end;
+};
+
+global_variable event_trace_state global_trace_state;
+
+bool32 event_trace_start_recording(uint64 max_bytes) {
+    event_trace_state* state = &global_trace_state;
+    if (state->recording) {
+        RH_WARN_CH(LOG_CHANNEL_EVENTS, "Already recording an event trace!");
+        return false;
+    }
+
+    state->buffer_size = max_bytes;
+    state->buffer = (uint8*)platform_alloc(max_bytes, 0);
+    if (!state->buffer) {
+        RH_ERROR_CH(LOG_CHANNEL_EVENTS, "Could not allocate %llu bytes for the event trace!", max_bytes);
+        return false;
+    }
+
+    // header is filled in when the trace is written out
+    state->buffer_used = sizeof(event_trace_header);
+    state->num_entries = 0;
+    state->overflowed  = false;
+    state->frame_index = 0;
+    state->start_clock = platform_get_wall_clock();
+    state->recording   = true;
+
+    RH_INFO_CH(LOG_CHANNEL_EVENTS, "Recording event trace.");
+    return true;
+}
+
+bool32 event_trace_stop_recording(const char* full_path) {
+    event_trace_state* state = &global_trace_state;
+    if (!state->recording) {
+        return false;
+    }
+    state->recording = false;
+
+    event_trace_header* header = (event_trace_header*)state->buffer;
+    header->magic       = EVENT_TRACE_MAGIC;
+    header->version     = EVENT_TRACE_VERSION;
+    header->num_entries = state->num_entries;
+
+    bool32 result = platform_write_entire_file(full_path, state->buffer, state->buffer_used);
+    if (result) {
+        RH_INFO_CH(LOG_CHANNEL_EVENTS, "Wrote %llu events (%llu bytes) to '%s'", state->num_entries, state->buffer_used, full_path);
+    } else {
+        RH_ERROR_CH(LOG_CHANNEL_EVENTS, "Failed to write event trace to '%s'", full_path);
+    }
+
+    platform_free(state->buffer);
+    state->buffer = nullptr;
+    state->buffer_size = 0;
+    state->buffer_used = 0;
+
+    return result;
+}
+
+bool32 event_trace_is_recording() {
+    return global_trace_state.recording;
+}
+
+void event_trace_record(uint16 code, void* sender, event_context context, const event_payload* payload) {
+    event_trace_state* state = &global_trace_state;
+    if (!state->recording) {
+        return;
+    }
+
+    uint64 payload_size = payload ? payload->size : 0;
+    if (payload_size > 0xFFFF) {
+        // leave the whole event out. without its payload, the context would be a dangling pointer on replay
+        RH_WARN_CH(LOG_CHANNEL_EVENTS, "Event code %d payload is too large to trace (%llu bytes), not recording it.", code, (unsigned long long)payload_size);
+        return;
+    }
+
+    uint64 entry_size = sizeof(event_trace_entry) + EVENT_TRACE_ALIGN(payload_size);
+    if (state->buffer_used + entry_size > state->buffer_size) {
+        if (!state->overflowed) {
+            RH_WARN_CH(LOG_CHANNEL_EVENTS, "Event trace buffer is full after %llu events, no longer recording!", state->num_entries);
+            state->overflowed = true;
+        }
+        return;
+    }
+
+    event_trace_entry* entry = (event_trace_entry*)(state->buffer + state->buffer_used);
+    entry->timestamp    = platform_get_wall_clock() - state->start_clock;
+    entry->sender       = (uint64)sender;
+    entry->context      = context.u64;
+    entry->frame        = state->frame_index;
+    entry->code         = code;
+    entry->payload_size = (uint16)payload_size;
+
+    if (payload_size) {
+        memory_copy(entry + 1, payload->data, payload_size);
+    }
+
+    state->buffer_used += entry_size;
+    state->num_entries++;
+}
+
+bool32 event_trace_start_replay(const char* full_path) {
+    event_trace_state* state = &global_trace_state;
+    if (state->replaying) {
+        event_trace_stop_replay();
+    }
+
+    // replayed straight out of the page cache. prefaulted, so a replay never waits on the disk mid-run
+    if (!platform_map_file(full_path, &state->replay_file, PLATFORM_MAP_SEQUENTIAL | PLATFORM_MAP_PREFAULT) ||
+        state->replay_file.num_bytes < sizeof(event_trace_header)) {
+        RH_ERROR_CH(LOG_CHANNEL_EVENTS, "Could not read event trace '%s'", full_path);
+        platform_unmap_file(&state->replay_file);
+        return false;
+    }
+
+    event_trace_header* header = (event_trace_header*)state->replay_file.data;
+    if (header->magic != EVENT_TRACE_MAGIC || header->version != EVENT_TRACE_VERSION) {
+        RH_ERROR_CH(LOG_CHANNEL_EVENTS, "'%s' is not a version %d event trace!", full_path, EVENT_TRACE_VERSION);
+        platform_unmap_file(&state->replay_file);
+        return false;
+    }
+
+    state->replay_scan = state->replay_file.data + sizeof(event_trace_header);
+    state->replay_end  = state->replay_file.data + state->replay_file.num_bytes;
+    state->frame_index = 0;
+    state->replaying   = true;
+
+    RH_INFO_CH(LOG_CHANNEL_EVENTS, "Replaying %llu events from '%s'", header->num_entries, full_path);
+    return true;
+}
+
+void event_trace_stop_replay() {
+    event_trace_state* state = &global_trace_state;
+    if (!state->replaying) {
+        return;
+    }
+
+    platform_unmap_file(&state->replay_file);
+    state->replay_scan = nullptr;
+    state->replay_end  = nullptr;
+    state->replaying   = false;
+}
+
+bool32 event_trace_is_replaying() {
+    return global_trace_state.replaying;
+}
+
+// replayed events skip the trace, and go to the same listeners the original did.
+template <typename Event_Type>
+internal_func bool32 event_trace_fire_typed(const event_trace_entry* entry) {
+    event_context context;
+    context.u64 = entry->context;
+
+    Event_Type event = {};
+    event_trace_typed<Event_Type>::unpack(context, (const uint8*)(entry + 1), entry->payload_size, &event);
+
+    if (event_listener_table<Event_Type>::dispatch(event)) {
+        return true;
+    }
+    return event_fire_listeners(Event_Type::code, 0, event_pack(event));
+}
+
+// untyped events with a payload get a fresh copy of it in this run's frame arena
+internal_func bool32 event_trace_fire_untyped(const event_trace_entry* entry) {
+    event_context context;
+    context.u64 = entry->context;
+    if (entry->payload_size) {
+        event_payload* payload = event_alloc_payload(entry->payload_size);
+        if (!payload) {
+            return false;
+        }
+        memory_copy(payload->data, entry + 1, entry->payload_size);
+        context.ptr = payload;
+    }
+    return event_fire_listeners(entry->code, 0, context);
+}
+
+internal_func bool32 event_trace_fire(const event_trace_entry* entry) {
+    switch (entry->code) {
+        case EVENT_CODE_APPLICATION_QUIT: return event_trace_fire_typed<event_application_quit>(entry);
+        case EVENT_CODE_KEY_PRESSED:      return event_trace_fire_typed<event_key_pressed>(entry);
+        case EVENT_CODE_KEY_RELEASED:     return event_trace_fire_typed<event_key_released>(entry);
+        case EVENT_CODE_BUTTON_PRESSED:   return event_trace_fire_typed<event_button_pressed>(entry);
+        case EVENT_CODE_BUTTON_RELEASED:  return event_trace_fire_typed<event_button_released>(entry);
+        case EVENT_CODE_MOUSE_MOVED:      return event_trace_fire_typed<event_mouse_moved>(entry);
+        case EVENT_CODE_MOUSE_WHEEL:      return event_trace_fire_typed<event_mouse_wheel>(entry);
+        case EVENT_CODE_RESIZED:          return event_trace_fire_typed<event_resized>(entry);
+        case EVENT_CODE_ACTION_PRESSED:   return event_trace_fire_typed<event_action_pressed>(entry);
+        default:                          return event_trace_fire_untyped(entry);
+    }
+}
+
+void event_trace_replay_frame() {
+    event_trace_state* state = &global_trace_state;
+    if (!state->replaying) {
+        return;
+    }
+
+    while (state->replay_scan + sizeof(event_trace_entry) <= state->replay_end) {
+        event_trace_entry* entry = (event_trace_entry*)state->replay_scan;
+        if (entry->frame > state->frame_index) {
+            break; // belongs to a later frame
+        }
+
+        uint64 entry_size = sizeof(event_trace_entry) + EVENT_TRACE_ALIGN(entry->payload_size);
+        if (state->replay_scan + entry_size > state->replay_end) {
+            RH_ERROR_CH(LOG_CHANNEL_EVENTS, "Event trace is truncated!");
+            break;
+        }
+        state->replay_scan += entry_size;
+
+        event_trace_fire(entry);
+    }
+
+    if (state->replay_scan + sizeof(event_trace_entry) > state->replay_end) {
+        RH_INFO_CH(LOG_CHANNEL_EVENTS, "Event trace replay finished on frame %u", state->frame_index);
+        event_trace_stop_replay();
+    }
+}
+
+void event_trace_end_frame() {
+    global_trace_state.frame_index++;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/Event.h"
+
+/*
+ * Event trace:
+ *   Records every fired event (wall clock timestamp, frame index, code, sender, context,
+ *   and payload bytes if any) into a compact binary log, and replays a log back into the
+ *   event system frame-by-frame on a later run.
+ *
+ *   Replay is keyed on the frame index, not the timestamp, so combined with a fixed
+ *   time-step the same frames see the same events every run.
+ *   Sender pointers are recorded for inspection, but replayed as 0.
+ * */
+
+RHAPI bool32 event_trace_start_recording(uint64 max_bytes);
+// writes the log to full_path. returns false if nothing could be written
+RHAPI bool32 event_trace_stop_recording(const char* full_path);
+RHAPI bool32 event_trace_is_recording();
+
+RHAPI bool32 event_trace_start_replay(const char* full_path);
+RHAPI void   event_trace_stop_replay();
+RHAPI bool32 event_trace_is_replaying();
+
+// fires every recorded event for the current frame
+void event_trace_replay_frame();
+// advances the frame index. called from event_end_frame()
+void event_trace_end_frame();
+
+void event_trace_record(uint16 code, void* sender, event_context context, const event_payload* payload);
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/Input.h"
+#include "Core/Event.h"
+#include "Core/Event_Trace.h"
+#include "Memory/Memory.h"
+
+/*
+ * Typed events:
+ *   Each event is a plain struct, passed by const reference to its listeners.
+ *   Listeners are bound at compile time with RH_EVENT_LISTENERS, so firing an
+ *   event is a chain of direct calls (no function pointers, no union packing).
+ *
+ *   The listener table for an event MUST be visible everywhere that event is
+ *   dispatched, so fire sites include "Core/Event_Listeners.h" rather than this file.
+ *
+ *   Dynamic listeners (registered at runtime) still go through event_register/event_fire.
+ *   event_fire_typed() does both: static listeners first, then the runtime ones with the
+ *   event packed into an event_context under its system_event_code. The event is only
+ *   packed if there are runtime listeners on that code, or an event trace is recording.
+ *
+ *   Events that don't fit in the 8-byte context (the button events, with the mouse position)
+ *   are traced with the whole struct as the entry's payload, and runtime listeners get the
+ *   part that fits.
+ * */
+
+enum key_modifiers {
+    KEY_MOD_NONE    = 0x00,
+    KEY_MOD_SHIFT   = 0x01,
+    KEY_MOD_CONTROL = 0x02,
+    KEY_MOD_ALT     = 0x04,
+};
+
+// shut down app on the next frame
+struct event_application_quit {
+    static const uint16 code = EVENT_CODE_APPLICATION_QUIT;
+};
+
+struct event_key_pressed {
+    static const uint16 code = EVENT_CODE_KEY_PRESSED;
+    keyboard_keys key;
+    uint32 modifiers; // key_modifiers flags
+};
+struct event_key_released {
+    static const uint16 code = EVENT_CODE_KEY_RELEASED;
+    keyboard_keys key;
+    uint32 modifiers; // key_modifiers flags
+};
+
+struct event_button_pressed {
+    static const uint16 code = EVENT_CODE_BUTTON_PRESSED;
+    mouse_button_codes button;
+    int32 mouse_x;
+    int32 mouse_y;
+};
+struct event_button_released {
+    static const uint16 code = EVENT_CODE_BUTTON_RELEASED;
+    mouse_button_codes button;
+    int32 mouse_x;
+    int32 mouse_y;
+};
+
+struct event_mouse_moved {
+    static const uint16 code = EVENT_CODE_MOUSE_MOVED;
+    int32 mouse_x;
+    int32 mouse_y;
+};
+struct event_mouse_wheel {
+    static const uint16 code = EVENT_CODE_MOUSE_WHEEL;
+    int32 z_delta;
+};
+
+struct event_resized {
+    static const uint16 code = EVENT_CODE_RESIZED;
+    uint32 width;
+    uint32 height;
+};
+
+// an input action the engine acts on went down. ids are only the same between runs
+// with the same bindings
+struct event_action_pressed {
+    static const uint16 code = EVENT_CODE_ACTION_PRESSED;
+    uint32 action;
+};
+
+// conversion to/from the packed event_context layout documented in Event.h.
+// the button events only pack the button, the mouse position doesn't fit
+inline event_context event_pack(const event_application_quit& event) {
+    event_context context = {};
+    return context;
+}
+inline event_context event_pack(const event_key_pressed& event) {
+    event_context context = {};
+    context.u16[0] = (uint16)event.key;
+    context.u16[1] = (uint16)event.modifiers;
+    return context;
+}
+inline event_context event_pack(const event_key_released& event) {
+    event_context context = {};
+    context.u16[0] = (uint16)event.key;
+    context.u16[1] = (uint16)event.modifiers;
+    return context;
+}
+inline event_context event_pack(const event_button_pressed& event) {
+    event_context context = {};
+    context.u16[0] = (uint16)event.button;
+    return context;
+}
+inline event_context event_pack(const event_button_released& event) {
+    event_context context = {};
+    context.u16[0] = (uint16)event.button;
+    return context;
+}
+inline event_context event_pack(const event_mouse_moved& event) {
+    event_context context = {};
+    context.i32[0] = event.mouse_x;
+    context.i32[1] = event.mouse_y;
+    return context;
+}
+inline event_context event_pack(const event_mouse_wheel& event) {
+    event_context context = {};
+    context.i32[0] = event.z_delta;
+    return context;
+}
+inline event_context event_pack(const event_resized& event) {
+    event_context context = {};
+    context.u32[0] = event.width;
+    context.u32[1] = event.height;
+    return context;
+}
+inline event_context event_pack(const event_action_pressed& event) {
+    event_context context = {};
+    context.u32[0] = event.action;
+    return context;
+}
+
+inline void event_unpack(event_context context, event_application_quit* event) {
+}
+inline void event_unpack(event_context context, event_key_pressed* event) {
+    event->key       = (keyboard_keys)context.u16[0];
+    event->modifiers = context.u16[1];
+}
+inline void event_unpack(event_context context, event_key_released* event) {
+    event->key       = (keyboard_keys)context.u16[0];
+    event->modifiers = context.u16[1];
+}
+inline void event_unpack(event_context context, event_button_pressed* event) {
+    event->button = (mouse_button_codes)context.u16[0];
+}
+inline void event_unpack(event_context context, event_button_released* event) {
+    event->button = (mouse_button_codes)context.u16[0];
+}
+inline void event_unpack(event_context context, event_mouse_moved* event) {
+    event->mouse_x = context.i32[0];
+    event->mouse_y = context.i32[1];
+}
+inline void event_unpack(event_context context, event_mouse_wheel* event) {
+    event->z_delta = context.i32[0];
+}
+inline void event_unpack(event_context context, event_resized* event) {
+    event->width  = context.u32[0];
+    event->height = context.u32[1];
+}
+inline void event_unpack(event_context context, event_action_pressed* event) {
+    event->action = context.u32[0];
+}
+
+// callback should return true if handled. (i.e. don't propoagte the message anymore)
+template <typename Event_Type, bool32 (*... Listeners)(const Event_Type&)>
+struct event_listener_list;
+
+template <typename Event_Type>
+struct event_listener_list<Event_Type> {
+    static inline bool32 dispatch(const Event_Type& event) {
+        return false;
+    }
+};
+
+template <typename Event_Type, bool32 (*First)(const Event_Type&), bool32 (*... Rest)(const Event_Type&)>
+struct event_listener_list<Event_Type, First, Rest...> {
+    static inline bool32 dispatch(const Event_Type& event) {
+        if (First(event)) {
+            return true; // handled, stop propogating this event
+        }
+        return event_listener_list<Event_Type, Rest...>::dispatch(event);
+    }
+};
+
+// default: nobody is listening. Specialized by RH_EVENT_LISTENERS.
+template <typename Event_Type>
+struct event_listener_table : event_listener_list<Event_Type> {
+};
+
+#define RH_EVENT_LISTENERS(Event_Type, ...)                                         \
+    template <>                                                                     \
+    struct event_listener_table<Event_Type> : event_listener_list<Event_Type, __VA_ARGS__> { \
+    }
+
+// returns true if any listener handled the event
+template <typename Event_Type>
+inline bool32 event_dispatch(const Event_Type& event) {
+    return event_listener_table<Event_Type>::dispatch(event);
+}
+
+// writing typed events to the event trace, and reading them back.
+// events that fit in the context are traced as their packed form
+template <typename Event_Type, bool Fits_In_Context = (sizeof(Event_Type) <= sizeof(event_context))>
+struct event_trace_typed {
+    static inline void record(const Event_Type& event, event_context context) {
+        event_trace_record(Event_Type::code, 0, context, nullptr);
+    }
+    static inline void unpack(event_context context, const uint8* payload_data, uint64 payload_size, Event_Type* event) {
+        event_unpack(context, event);
+    }
+};
+
+// the rest go in whole, as the entry's payload
+template <typename Event_Type>
+struct event_trace_typed<Event_Type, false> {
+    static inline void record(const Event_Type& event, event_context context) {
+        event_payload payload;
+        payload.size = sizeof(Event_Type);
+        payload.data = (uint8*)&event;
+        event_trace_record(Event_Type::code, 0, context, &payload);
+    }
+    static inline void unpack(event_context context, const uint8* payload_data, uint64 payload_size, Event_Type* event) {
+        if (payload_data && payload_size == sizeof(Event_Type)) {
+            memory_copy(event, payload_data, sizeof(Event_Type));
+        } else {
+            event_unpack(context, event); // traced before the event got bigger
+        }
+    }
+};
+
+// static listeners first, then anyone registered at runtime with event_register.
+// only packed into an event_context if something is going to look at it
+template <typename Event_Type>
+inline bool32 event_fire_typed(const Event_Type& event) {
+    bool32 recording = event_trace_is_recording();
+    bool32 has_listeners = event_has_listeners(Event_Type::code);
+    if (!recording && !has_listeners) {
+        return event_listener_table<Event_Type>::dispatch(event);
+    }
+
+    event_context context = event_pack(event);
+    if (recording) {
+        event_trace_typed<Event_Type>::record(event, context);
+    }
+
+    if (event_listener_table<Event_Type>::dispatch(event)) {
+        return true;
+    }
+    return has_listeners ? event_fire_listeners(Event_Type::code, 0, context) : false;
+}
@@ -0,0 +1,104 @@
+#include "File_Batch.h"
+
+#include "Core/Logger.h"
+#include "Core/Asserts.h"
+#include "Platform/Platform.h"
+
+#define FILE_BATCH_WAIT_MS 100
+
+struct file_batch_slot {
+    async_read read;
+    uint32 index;
+};
+
+// closes the file and frees the buffer of a read that's done (or never started)
+internal_func void file_batch_release(file_batch_slot* slot) {
+    platform_close_async_file(slot->read.file);
+    platform_free(slot->read.buffer);
+    slot->read = {};
+}
+
+uint32 file_batch_load(const char** full_paths, uint32 num_files, file_batch_callback on_loaded, void* user_data) {
+    AssertMsg(platform_async_num_in_flight() == 0, "Can't load a file batch while other async reads are in flight!");
+
+    file_batch_slot slots[FILE_BATCH_MAX_IN_FLIGHT];
+    file_batch_slot* free_slots[FILE_BATCH_MAX_IN_FLIGHT];
+    uint32 num_free = FILE_BATCH_MAX_IN_FLIGHT;
+    for (uint32 n = 0; n < FILE_BATCH_MAX_IN_FLIGHT; n++) {
+        free_slots[n] = &slots[FILE_BATCH_MAX_IN_FLIGHT - 1 - n];
+    }
+
+    uint32 next_file = 0;
+    uint32 num_loaded = 0;
+    int64 start = platform_get_wall_clock();
+    uint64 total_bytes = 0;
+
+    while (next_file < num_files || num_free < FILE_BATCH_MAX_IN_FLIGHT) {
+        // top up the queue before handing anything out, so the disk has work while we parse
+        while (next_file < num_files && num_free > 0) {
+            uint32 index = next_file;
+            const char* full_path = full_paths[index];
+
+            file_batch_slot* slot = free_slots[num_free - 1];
+            *slot = {};
+            slot->index = index;
+
+            uint64 num_bytes = 0;
+            slot->read.file = platform_open_async_file(full_path, &num_bytes);
+            if (!slot->read.file) {
+                RH_ERROR("Could not open '%s'", full_path);
+                next_file++;
+                on_loaded(index, full_path, nullptr, 0, user_data);
+                continue;
+            }
+
+            // +1 for a null-terminator, same as platform_read_entire_file
+            slot->read.buffer = platform_alloc(num_bytes + 1, 0);
+            if (!slot->read.buffer) {
+                RH_ERROR("Could not allocate %llu bytes for '%s'", num_bytes, full_path);
+                file_batch_release(slot);
+                next_file++;
+                on_loaded(index, full_path, nullptr, 0, user_data);
+                continue;
+            }
+            slot->read.num_bytes = num_bytes;
+            slot->read.user_data = slot;
+
+            if (!platform_async_read(&slot->read)) {
+                // the platform queue is smaller than ours, try again once something comes back
+                file_batch_release(slot);
+                break;
+            }
+            next_file++;
+            num_free--;
+        }
+        platform_async_submit();
+
+        async_read* completed[FILE_BATCH_MAX_IN_FLIGHT];
+        uint32 num_completed = platform_async_wait(completed, FILE_BATCH_MAX_IN_FLIGHT, FILE_BATCH_WAIT_MS);
+        for (uint32 n = 0; n < num_completed; n++) {
+            file_batch_slot* slot = (file_batch_slot*)completed[n]->user_data;
+            const char* full_path = full_paths[slot->index];
+
+            // a short read means the file shrank since it was opened
+            if (slot->read.status == ASYNC_READ_DONE && slot->read.bytes_read == slot->read.num_bytes) {
+                uint8* data = (uint8*)slot->read.buffer;
+                data[slot->read.num_bytes] = 0;
+                on_loaded(slot->index, full_path, data, slot->read.num_bytes, user_data);
+                total_bytes += slot->read.num_bytes;
+                num_loaded++;
+            } else {
+                RH_ERROR("Could not read '%s'", full_path);
+                on_loaded(slot->index, full_path, nullptr, 0, user_data);
+            }
+
+            file_batch_release(slot);
+            free_slots[num_free++] = slot;
+        }
+    }
+
+    real64 seconds = platform_get_seconds_elapsed(start, platform_get_wall_clock());
+    RH_DEBUG("Loaded %u of %u files (%.2f MB) in %.2f ms", num_loaded, num_files,
+             (real64)total_bytes / (real64)Megabytes(1), 1000.0 * seconds);
+    return num_loaded;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * File batches:
+ *   Loads a list of files through the async reads in Platform.h. Up to FILE_BATCH_MAX_IN_FLIGHT
+ *   reads are kept queued at the disk, and each file is handed to the callback as soon as it's
+ *   in memory, so parsing one file overlaps with reading the next ones. Files come back in
+ *   whatever order the reads finish.
+ *
+ *   Needs platform_async_io_init(), and nothing else can have async reads in flight while
+ *   a batch is loading.
+ * */
+
+#define FILE_BATCH_MAX_IN_FLIGHT 32
+
+// data is null-terminated, and only valid during the call. data is nullptr if the file couldn't be read
+typedef void (*file_batch_callback)(uint32 index, const char* full_path, const uint8* data, uint64 num_bytes, void* user_data);
+
+// calls on_loaded once for every file. returns how many were read
+RHAPI uint32 file_batch_load(const char** full_paths, uint32 num_files, file_batch_callback on_loaded, void* user_data);
@@ -0,0 +1,261 @@
+#include "Frame_Pacer.h"
+
+#include "Core/Logger.h"
+#include "Core/Percentile.h"
+#include "Memory/Memory.h"
+#include "Platform/Platform.h"
+
+#include <math.h>
+
+// the spin window follows the wake-up lateness with fixed steps, up FRAME_PACER_STEPS_UP
+// times as far as down. it settles where 1 in (FRAME_PACER_STEPS_UP + 1) wake-ups is later
+// than the window (the 95th percentile), so rare multi-millisecond preemptions don't make
+// every frame spin for that long
+#define FRAME_PACER_STEP_US  5.0
+#define FRAME_PACER_STEPS_UP 19.0
+// how much more than the oversleep to spin
+#define FRAME_PACER_MARGIN 1.25
+// later than 1/FRAME_PACER_LATE_FRACTION of a period past the deadline resets the cadence
+#define FRAME_PACER_LATE_FRACTION 8
+
+struct frame_pacer_state {
+    int64  ticks_per_second;
+    int64  period; // ticks, 0 if not limiting
+    int64  next_deadline;
+    int64  last_frame_start;
+    real32 target_ms;
+
+    // the coarse sleep wakes up this many ticks ahead of the deadline
+    real64 spin_window;
+    real64 min_spin_window;
+    real64 max_spin_window;
+    real64 spin_step;
+
+    // last FRAME_PACER_WINDOW frames, indexed with a running count
+    real32 window_ms[FRAME_PACER_WINDOW];
+    real32 window_spin_ms[FRAME_PACER_WINDOW];
+    bool32 window_missed[FRAME_PACER_WINDOW];
+    uint32 window_write;
+
+    // whole run
+    uint32 histogram[FRAME_PACER_NUM_BUCKETS]; // |frame time - target|
+    uint32 num_frames;
+    uint32 num_missed;
+    real64 sum_ms;
+    real64 sum_sq_ms;
+    real64 sum_spin_ms;
+    real32 max_error_ms;
+};
+
+global_variable frame_pacer_state global_pacer_state;
+
+internal_func real64 frame_pacer_ticks_to_ms(frame_pacer_state* state, real64 ticks) {
+    return 1000.0 * ticks / (real64)state->ticks_per_second;
+}
+
+void frame_pacer_init(real32 target_hz) {
+    frame_pacer_state* state = &global_pacer_state;
+    memory_zero(state, sizeof(frame_pacer_state));
+
+    state->ticks_per_second = platform_get_wall_clock_frequency();
+    real64 ticks_per_us = (real64)state->ticks_per_second * 1.0e-6;
+    state->min_spin_window = FRAME_PACER_MIN_SPIN_US   * ticks_per_us;
+    state->spin_window     = FRAME_PACER_START_SPIN_US * ticks_per_us;
+    state->max_spin_window = FRAME_PACER_MAX_SPIN_US   * ticks_per_us;
+    state->spin_step       = FRAME_PACER_STEP_US       * ticks_per_us;
+
+    frame_pacer_set_target(target_hz);
+}
+
+void frame_pacer_set_target(real32 target_hz) {
+    frame_pacer_state* state = &global_pacer_state;
+    if (target_hz > 0.0f) {
+        state->period    = (int64)((real64)state->ticks_per_second / (real64)target_hz);
+        state->target_ms = 1000.0f / target_hz;
+    } else {
+        state->period    = 0;
+        state->target_ms = 0.0f;
+    }
+
+    // start the cadence over from now
+    state->last_frame_start = platform_get_wall_clock();
+    state->next_deadline    = state->last_frame_start + state->period;
+}
+
+// oversleep is how far past the requested wake-up time the timer actually woke us
+internal_func void frame_pacer_calibrate(frame_pacer_state* state, int64 oversleep) {
+    real64 wanted = FRAME_PACER_MARGIN * (real64)oversleep;
+    if (wanted > state->spin_window) {
+        state->spin_window += FRAME_PACER_STEPS_UP * state->spin_step;
+    } else {
+        state->spin_window -= state->spin_step;
+    }
+
+    if (state->spin_window < state->min_spin_window) state->spin_window = state->min_spin_window;
+    if (state->spin_window > state->max_spin_window) state->spin_window = state->max_spin_window;
+}
+
+internal_func void frame_pacer_record(frame_pacer_state* state, real32 frame_ms, real32 spin_ms, bool32 missed) {
+    uint32 slot = state->window_write & (FRAME_PACER_WINDOW - 1);
+    state->window_ms[slot]      = frame_ms;
+    state->window_spin_ms[slot] = spin_ms;
+    state->window_missed[slot]  = missed;
+    state->window_write++;
+
+    state->num_frames++;
+    state->num_missed  += missed ? 1 : 0;
+    state->sum_ms      += frame_ms;
+    state->sum_sq_ms   += (real64)frame_ms * (real64)frame_ms;
+    state->sum_spin_ms += spin_ms;
+
+    if (state->period > 0) {
+        real32 error_ms = fabsf(frame_ms - state->target_ms);
+        uint32 bucket = (uint32)(1000.0f * error_ms / FRAME_PACER_BUCKET_US);
+        if (bucket >= FRAME_PACER_NUM_BUCKETS) {
+            bucket = FRAME_PACER_NUM_BUCKETS - 1;
+        }
+        state->histogram[bucket]++;
+        if (error_ms > state->max_error_ms) {
+            state->max_error_ms = error_ms;
+        }
+    }
+}
+
+real32 frame_pacer_wait() {
+    frame_pacer_state* state = &global_pacer_state;
+    int64 now = platform_get_wall_clock();
+    int64 spin_ticks = 0;
+    bool32 missed = false;
+
+    if (state->period > 0) {
+        if (now >= state->next_deadline) {
+            missed = true;
+        } else {
+            int64 wake_time = state->next_deadline - (int64)state->spin_window;
+            if (wake_time > now) {
+                platform_sleep_until(wake_time);
+                now = platform_get_wall_clock();
+                frame_pacer_calibrate(state, now - wake_time);
+            }
+
+            int64 spin_start = now;
+            while (now < state->next_deadline) {
+                platform_cpu_pause();
+                now = platform_get_wall_clock();
+            }
+            spin_ticks = now - spin_start;
+        }
+
+        // well past the deadline (missed, or woke up late): start the cadence over from now,
+        // otherwise the next frame comes out short by as much as this one was long
+        if (now - state->next_deadline > state->period / FRAME_PACER_LATE_FRACTION) {
+            state->next_deadline = now;
+        }
+        state->next_deadline += state->period;
+    }
+
+    real64 frame_ticks = (real64)(now - state->last_frame_start);
+    state->last_frame_start = now;
+
+    frame_pacer_record(state,
+                       (real32)frame_pacer_ticks_to_ms(state, frame_ticks),
+                       (real32)frame_pacer_ticks_to_ms(state, (real64)spin_ticks),
+                       missed);
+    return (real32)(frame_ticks / (real64)state->ticks_per_second);
+}
+
+internal_func real32 frame_pacer_p99_from_histogram(const uint32* histogram, uint32 count, real32 max_ms) {
+    return p99_from_histogram(histogram, FRAME_PACER_NUM_BUCKETS, FRAME_PACER_BUCKET_US * 0.001f, count, max_ms);
+}
+
+internal_func real32 frame_pacer_stddev(real64 sum, real64 sum_sq, uint32 count) {
+    real64 mean = sum / (real64)count;
+    real64 variance = sum_sq / (real64)count - mean*mean;
+    return (variance > 0.0) ? (real32)sqrt(variance) : 0.0f;
+}
+
+void frame_pacer_get_recent(frame_pacer_stats* stats) {
+    frame_pacer_state* state = &global_pacer_state;
+    memory_zero(stats, sizeof(frame_pacer_stats));
+    stats->target_ms      = state->target_ms;
+    stats->spin_window_ms = (real32)frame_pacer_ticks_to_ms(state, state->spin_window);
+
+    uint32 count = (state->window_write < FRAME_PACER_WINDOW) ? state->window_write : FRAME_PACER_WINDOW;
+    if (count == 0) {
+        return;
+    }
+
+    // the window is small enough to bucket again each time
+    uint32 histogram[FRAME_PACER_NUM_BUCKETS] = {};
+    real64 sum = 0.0;
+    real64 sum_sq = 0.0;
+    real64 sum_spin = 0.0;
+    for (uint32 n = 0; n < count; n++) {
+        real32 frame_ms = state->window_ms[n];
+        sum      += frame_ms;
+        sum_sq   += (real64)frame_ms * (real64)frame_ms;
+        sum_spin += state->window_spin_ms[n];
+        stats->num_missed += state->window_missed[n] ? 1 : 0;
+
+        if (state->period > 0) {
+            real32 error_ms = fabsf(frame_ms - state->target_ms);
+            uint32 bucket = (uint32)(1000.0f * error_ms / FRAME_PACER_BUCKET_US);
+            histogram[(bucket < FRAME_PACER_NUM_BUCKETS) ? bucket : FRAME_PACER_NUM_BUCKETS - 1]++;
+            if (error_ms > stats->max_error_ms) {
+                stats->max_error_ms = error_ms;
+            }
+        }
+    }
+
+    stats->num_frames = count;
+    stats->mean_ms    = (real32)(sum / (real64)count);
+    stats->jitter_ms  = frame_pacer_stddev(sum, sum_sq, count);
+    stats->spin_ms    = (real32)(sum_spin / (real64)count);
+    if (state->period > 0) {
+        stats->p99_error_ms = frame_pacer_p99_from_histogram(histogram, count, stats->max_error_ms);
+    }
+}
+
+void frame_pacer_get_total(frame_pacer_stats* stats) {
+    frame_pacer_state* state = &global_pacer_state;
+    memory_zero(stats, sizeof(frame_pacer_stats));
+    stats->target_ms      = state->target_ms;
+    stats->spin_window_ms = (real32)frame_pacer_ticks_to_ms(state, state->spin_window);
+    if (state->num_frames == 0) {
+        return;
+    }
+
+    stats->num_frames   = state->num_frames;
+    stats->num_missed   = state->num_missed;
+    stats->mean_ms      = (real32)(state->sum_ms / (real64)state->num_frames);
+    stats->jitter_ms    = frame_pacer_stddev(state->sum_ms, state->sum_sq_ms, state->num_frames);
+    stats->spin_ms      = (real32)(state->sum_spin_ms / (real64)state->num_frames);
+    stats->max_error_ms = state->max_error_ms;
+
+    // frames before a target change count too, against the target they had
+    uint32 num_errors = 0;
+    for (uint32 bucket = 0; bucket < FRAME_PACER_NUM_BUCKETS; bucket++) {
+        num_errors += state->histogram[bucket];
+    }
+    if (num_errors) {
+        stats->p99_error_ms = frame_pacer_p99_from_histogram(state->histogram, num_errors, state->max_error_ms);
+    }
+}
+
+void frame_pacer_log_report() {
+    frame_pacer_stats stats;
+    frame_pacer_get_total(&stats);
+    if (stats.num_frames == 0) {
+        return;
+    }
+
+    if (stats.target_ms > 0.0f) {
+        RH_INFO("Frame pacing over %u frames, target %.3f ms: mean %.3f ms, jitter %.3f ms, "
+                "p99 error %.3f ms, max error %.3f ms, %u missed, spinning %.3f ms/frame (window %.3f ms)",
+                stats.num_frames, stats.target_ms, stats.mean_ms, stats.jitter_ms,
+                stats.p99_error_ms, stats.max_error_ms, stats.num_missed, stats.spin_ms, stats.spin_window_ms);
+    } else {
+        RH_INFO("Frame times over %u frames (not limited): mean %.3f ms, jitter %.3f ms",
+                stats.num_frames, stats.mean_ms, stats.jitter_ms);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * Frame pacing:
+ *   Holds the main loop to a target frame rate. Each frame has a deadline, one period
+ *   after the last one. frame_pacer_wait() sleeps on the os's high resolution timer
+ *   (platform_sleep_until) until shortly before the deadline, then spins the rest.
+ *
+ *   The spin window is calibrated from how late the timer actually wakes up, so that about
+ *   19 in 20 wake-ups still land ahead of the deadline. So the core only spins for the last
+ *   hundred microseconds or so, instead of the whole frame.
+ *
+ *   A frame whose work runs past its deadline counts as missed. A frame that starts well
+ *   past its deadline (missed, or the timer woke up late) starts the cadence over, so the
+ *   next one doesn't come out short to catch up.
+ *
+ *   Frame time is the time between two frame_pacer_wait() calls. Recent stats cover the
+ *   last FRAME_PACER_WINDOW frames, total stats the whole run, with the p99 taken from a
+ *   histogram in FRAME_PACER_BUCKET_US steps.
+ * */
+
+#define FRAME_PACER_WINDOW      256 // must be a power of 2
+#define FRAME_PACER_BUCKET_US   10.0f
+#define FRAME_PACER_NUM_BUCKETS 2000 // errors over 20ms all land in the last bucket
+
+#define FRAME_PACER_MIN_SPIN_US   50.0f
+#define FRAME_PACER_START_SPIN_US 300.0f
+#define FRAME_PACER_MAX_SPIN_US   1000.0f
+
+struct frame_pacer_stats {
+    uint32 num_frames;
+    uint32 num_missed;   // the frame's work alone took longer than the target
+    real32 target_ms;    // 0 if not limiting
+    real32 mean_ms;
+    real32 jitter_ms;    // standard deviation of the frame time
+    real32 p99_error_ms; // 99% of frames were at most this far from the target
+    real32 max_error_ms;
+    real32 spin_ms;      // average time spent spinning per frame
+    real32 spin_window_ms; // current calibrated spin window
+};
+
+// target_hz of 0 doesn't limit the frame rate, but still keeps stats
+RHAPI void frame_pacer_init(real32 target_hz);
+RHAPI void frame_pacer_set_target(real32 target_hz);
+
+// call once per frame. waits for the frame's deadline, and returns the frame time in seconds
+RHAPI real32 frame_pacer_wait();
+
+// all zero if there are no frames yet
+RHAPI void frame_pacer_get_recent(frame_pacer_stats* stats);
+RHAPI void frame_pacer_get_total(frame_pacer_stats* stats);
+
+// logs the total stats
+RHAPI void frame_pacer_log_report();
@@ -0,0 +1,261 @@
+#include "Hash.h"
+
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// same words as hash_secret_word(), but in memory for the SIMD loads
+#define HASH_SECRET_ENTRY4(N) hash_secret_word(N), hash_secret_word(N + 1), hash_secret_word(N + 2), hash_secret_word(N + 3)
+global_variable const uint64 hash_secret[HASH_SECRET_WORDS] = {
+    HASH_SECRET_ENTRY4(0),  HASH_SECRET_ENTRY4(4),  HASH_SECRET_ENTRY4(8),  HASH_SECRET_ENTRY4(12),
+    HASH_SECRET_ENTRY4(16), HASH_SECRET_ENTRY4(20), HASH_SECRET_ENTRY4(24), HASH_SECRET_ENTRY4(28),
+    HASH_SECRET_ENTRY4(32), HASH_SECRET_ENTRY4(36),
+};
+
+struct hash_ops_memory {
+    typedef const uint8* pointer;
+
+    static inline uint64 secret(uint32 index) {
+        return hash_secret[index];
+    }
+    static inline uint32 read8(pointer p, uint64 offset) {
+        return p[offset];
+    }
+    static inline uint64 read32(pointer p, uint64 offset) {
+        uint32 value;
+        memcpy(&value, p + offset, sizeof(value));
+        return value;
+    }
+    static inline uint64 read64(pointer p, uint64 offset) {
+        uint64 value;
+        memcpy(&value, p + offset, sizeof(value));
+        return value;
+    }
+    static inline uint64 mul128_fold(uint64 a, uint64 b) {
+#if defined(_MSC_VER)
+        uint64 high;
+        uint64 low = _umul128(a, b, &high);
+        return low ^ high;
+#else
+        unsigned __int128 product = (unsigned __int128)a * b;
+        return (uint64)product ^ (uint64)(product >> 64);
+#endif
+    }
+};
+typedef hash_impl<hash_ops_memory> hash_runtime;
+
+/* Long inputs:
+ *   Same math as hash_impl::accumulate_stripe/scramble, on 2 (SSE2) or 4 (AVX2) lanes
+ *   at a time. The 32x32->64 multiply is _mm_mul_epu32 on the low and high halves of
+ *   each keyed lane, and each lane's value is added to its neighbour with a shuffle.
+ * */
+#if defined(__AVX2__)
+internal_func inline void hash_accumulate_stripe(uint64* acc, const uint8* data, const uint64* secret) {
+    for (uint32 n = 0; n < 2; n++) {
+        __m256i a     = _mm256_loadu_si256((const __m256i*)acc + n);
+        __m256i value = _mm256_loadu_si256((const __m256i*)data + n);
+        __m256i keyed = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*)secret + n));
+
+        __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+        a = _mm256_add_epi64(a, _mm256_add_epi64(product, swapped));
+        _mm256_storeu_si256((__m256i*)acc + n, a);
+    }
+}
+
+internal_func inline void hash_scramble(uint64* acc) {
+    const __m256i prime = _mm256_set1_epi32((int32)HASH_PRIME32_1);
+    for (uint32 n = 0; n < 2; n++) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)acc + n);
+        a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+        a = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i*)(hash_secret + HASH_SECRET_SCRAMBLE) + n));
+
+        // 64x32 multiply: low*prime + (high*prime << 32)
+        __m256i low  = _mm256_mul_epu32(a, prime);
+        __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+        a = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+        _mm256_storeu_si256((__m256i*)acc + n, a);
+    }
+}
+#else
+internal_func inline void hash_accumulate_stripe(uint64* acc, const uint8* data, const uint64* secret) {
+    for (uint32 n = 0; n < 4; n++) {
+        __m128i a     = _mm_loadu_si128((const __m128i*)acc + n);
+        __m128i value = _mm_loadu_si128((const __m128i*)data + n);
+        __m128i keyed = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*)secret + n));
+
+        __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+        a = _mm_add_epi64(a, _mm_add_epi64(product, swapped));
+        _mm_storeu_si128((__m128i*)acc + n, a);
+    }
+}
+
+internal_func inline void hash_scramble(uint64* acc) {
+    const __m128i prime = _mm_set1_epi32((int32)HASH_PRIME32_1);
+    for (uint32 n = 0; n < 4; n++) {
+        __m128i a = _mm_loadu_si128((const __m128i*)acc + n);
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i*)(hash_secret + HASH_SECRET_SCRAMBLE) + n));
+
+        // 64x32 multiply: low*prime + (high*prime << 32)
+        __m128i low  = _mm_mul_epu32(a, prime);
+        __m128i high = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+        a = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+        _mm_storeu_si128((__m128i*)acc + n, a);
+    }
+}
+#endif
+
+// stripe_index is the position in the current block, and carries over between calls
+internal_func void hash_accumulate(uint64* acc, const uint8* data, uint64 num_stripes, uint32* stripe_index) {
+    uint32 index = *stripe_index;
+    for (uint64 n = 0; n < num_stripes; n++) {
+        hash_accumulate_stripe(acc, data + n*HASH_STRIPE_SIZE, hash_secret + index);
+        if (++index == HASH_STRIPES_PER_BLOCK) {
+            hash_scramble(acc);
+            index = 0;
+        }
+    }
+    *stripe_index = index;
+}
+
+internal_func void hash_long_acc(uint64* acc, const uint8* data, uint64 length, uint64 seed) {
+    hash_runtime::init_acc(acc, seed);
+
+    uint32 stripe_index = 0;
+    hash_accumulate(acc, data, (length - 1) / HASH_STRIPE_SIZE, &stripe_index);
+    hash_accumulate_stripe(acc, data + length - HASH_STRIPE_SIZE, hash_secret + HASH_SECRET_LAST_STRIPE);
+}
+
+uint64 hash_bytes64(const void* data, uint64 length, uint64 seed) {
+    const uint8* bytes = (const uint8*)data;
+    if (length <= HASH_MAX_SHORT_SIZE) {
+        return hash_runtime::short_hash(bytes, length, seed, 0);
+    }
+
+    uint64 acc[8];
+    hash_long_acc(acc, bytes, length, seed);
+    return hash_runtime::merge(acc, HASH_SECRET_MERGE_LOW, length * HASH_PRIME64_1);
+}
+
+hash128 hash_bytes128(const void* data, uint64 length, uint64 seed) {
+    const uint8* bytes = (const uint8*)data;
+    hash128 result;
+    if (length <= HASH_MAX_SHORT_SIZE) {
+        result.low  = hash_runtime::short_hash(bytes, length, seed, 0);
+        result.high = hash_runtime::short_hash(bytes, length, seed, HASH_SECRET_HIGH);
+        return result;
+    }
+
+    uint64 acc[8];
+    hash_long_acc(acc, bytes, length, seed);
+    result.low  = hash_runtime::merge(acc, HASH_SECRET_MERGE_LOW, length * HASH_PRIME64_1);
+    result.high = hash_runtime::merge(acc, HASH_SECRET_MERGE_HIGH, ~(length * HASH_PRIME64_2));
+    return result;
+}
+
+/* Streaming:
+ *   Input collects in the buffer until there's more than HASH_BUFFER_SIZE, at which point
+ *   it's definitely a long hash, and full stripes get consumed. Stripes are only consumed
+ *   once there is data after them, so the final 1-64 bytes are always left for the
+ *   finish, same as the one-shot version.
+ *
+ *   If the final stripe needs bytes from before the buffered ones, they're still at the
+ *   end of the buffer (copied there when stripes were read straight from the input).
+ * */
+void hash_begin(hash_state* state, uint64 seed) {
+    hash_runtime::init_acc(state->acc, seed);
+    state->total_length = 0;
+    state->seed = seed;
+    state->buffered = 0;
+    state->stripe_index = 0;
+}
+
+void hash_update(hash_state* state, const void* data, uint64 length) {
+    const uint8* bytes = (const uint8*)data;
+    state->total_length += length;
+
+    if (state->buffered + length <= HASH_BUFFER_SIZE) {
+        memcpy(state->buffer + state->buffered, bytes, length);
+        state->buffered += (uint32)length;
+        return;
+    }
+
+    // more is coming after the buffer, so all of it can be consumed
+    if (state->buffered) {
+        uint32 fill = HASH_BUFFER_SIZE - state->buffered;
+        memcpy(state->buffer + state->buffered, bytes, fill);
+        bytes  += fill;
+        length -= fill;
+        hash_accumulate(state->acc, state->buffer, HASH_BUFFER_SIZE / HASH_STRIPE_SIZE, &state->stripe_index);
+        state->buffered = 0;
+    }
+
+    if (length > HASH_BUFFER_SIZE) {
+        uint64 num_stripes = (length - 1) / HASH_STRIPE_SIZE;
+        hash_accumulate(state->acc, bytes, num_stripes, &state->stripe_index);
+        bytes  += num_stripes*HASH_STRIPE_SIZE;
+        length -= num_stripes*HASH_STRIPE_SIZE;
+
+        // keep the last stripe around, in case the final one overlaps it
+        memcpy(state->buffer + HASH_BUFFER_SIZE - HASH_STRIPE_SIZE, bytes - HASH_STRIPE_SIZE, HASH_STRIPE_SIZE);
+    }
+
+    memcpy(state->buffer, bytes, length);
+    state->buffered = (uint32)length;
+}
+
+// accumulates what's left in the buffer (without changing the state)
+internal_func void hash_finish_acc(const hash_state* state, uint64* acc) {
+    memcpy(acc, state->acc, sizeof(state->acc));
+    uint32 stripe_index = state->stripe_index;
+
+    uint32 buffered = state->buffered;
+    if (buffered >= HASH_STRIPE_SIZE) {
+        hash_accumulate(acc, state->buffer, (buffered - 1) / HASH_STRIPE_SIZE, &stripe_index);
+        hash_accumulate_stripe(acc, state->buffer + buffered - HASH_STRIPE_SIZE, hash_secret + HASH_SECRET_LAST_STRIPE);
+    } else {
+        // the last stripe starts in what was consumed before
+        uint8 last_stripe[HASH_STRIPE_SIZE];
+        uint32 earlier = HASH_STRIPE_SIZE - buffered;
+        memcpy(last_stripe, state->buffer + HASH_BUFFER_SIZE - earlier, earlier);
+        memcpy(last_stripe + earlier, state->buffer, buffered);
+        hash_accumulate_stripe(acc, last_stripe, hash_secret + HASH_SECRET_LAST_STRIPE);
+    }
+}
+
+uint64 hash_finish64(const hash_state* state) {
+    uint64 length = state->total_length;
+    if (length <= HASH_MAX_SHORT_SIZE) {
+        return hash_runtime::short_hash(state->buffer, length, state->seed, 0);
+    }
+
+    uint64 acc[8];
+    hash_finish_acc(state, acc);
+    return hash_runtime::merge(acc, HASH_SECRET_MERGE_LOW, length * HASH_PRIME64_1);
+}
+
+hash128 hash_finish128(const hash_state* state) {
+    uint64 length = state->total_length;
+    hash128 result;
+    if (length <= HASH_MAX_SHORT_SIZE) {
+        result.low  = hash_runtime::short_hash(state->buffer, length, state->seed, 0);
+        result.high = hash_runtime::short_hash(state->buffer, length, state->seed, HASH_SECRET_HIGH);
+        return result;
+    }
+
+    uint64 acc[8];
+    hash_finish_acc(state, acc);
+    result.low  = hash_runtime::merge(acc, HASH_SECRET_MERGE_LOW, length * HASH_PRIME64_1);
+    result.high = hash_runtime::merge(acc, HASH_SECRET_MERGE_HIGH, ~(length * HASH_PRIME64_2));
+    return result;
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * Hashing:
+ *   Fast non-cryptographic 64 and 128-bit hashes, in the xxHash3/wyhash family.
+ *   Don't use these for anything security related!
+ *
+ *   - Up to 240 bytes: a few 64x64->128 bit multiplies, chosen by length.
+ *   - Longer: 8 64-bit lanes are fed 64-byte stripes (SSE2/AVX2), scrambled every
+ *     1 KB, and merged down at the end.
+ *
+ *   hash_begin/hash_update/hash_finish give the same result as the one-shot
+ *   functions, however the input is split up.
+ *
+ *   hash_const64/128 are constexpr versions for string literals and other compile-time
+ *   data, and give the same value as the runtime versions:
+ *       switch (hash_bytes64(name, length)) { case RH_HASH("diffuse"): ... }
+ *
+ *   Results are the same on every platform (little-endian), so they can be saved to disk.
+ * */
+
+struct hash128 {
+    uint64 low;
+    uint64 high;
+};
+inline bool operator==(hash128 a, hash128 b) { return a.low == b.low && a.high == b.high; }
+inline bool operator!=(hash128 a, hash128 b) { return !(a == b); }
+
+RHAPI uint64  hash_bytes64(const void* data, uint64 length, uint64 seed = 0);
+RHAPI hash128 hash_bytes128(const void* data, uint64 length, uint64 seed = 0);
+
+// streaming
+#define HASH_STRIPE_SIZE    64
+#define HASH_BUFFER_SIZE    256 // 4 stripes
+#define HASH_MAX_SHORT_SIZE 240 // anything bigger goes through the stripes
+
+struct hash_state {
+    uint64 acc[8];
+    uint8 buffer[HASH_BUFFER_SIZE];
+    uint64 total_length;
+    uint64 seed;
+    uint32 buffered;
+    uint32 stripe_index; // position in the current 1 KB block
+};
+
+RHAPI void    hash_begin(hash_state* state, uint64 seed = 0);
+RHAPI void    hash_update(hash_state* state, const void* data, uint64 length);
+// the state can keep being updated after these
+RHAPI uint64  hash_finish64(const hash_state* state);
+RHAPI hash128 hash_finish128(const hash_state* state);
+
+
+/* ---------------------------------------------------------------------------------------
+ * Everything below is shared between the runtime and constexpr versions.
+ * Ops provides the memory reads and the 128-bit multiply, so the runtime version (in
+ * Hash.cpp) can use memcpy and intrinsics, while the constexpr one uses plain shifts.
+ * --------------------------------------------------------------------------------------- */
+
+#define HASH_PRIME32_1 0x9E3779B1U
+#define HASH_PRIME32_2 0x85EBCA77U
+#define HASH_PRIME32_3 0xC2B2AE3DU
+#define HASH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME64_3 0x165667B19E3779F9ULL
+#define HASH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define HASH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+// secret words. the stripes use [0, 24), the scramble [24, 32), the last stripe [25, 33),
+// and the short paths [0, 19) for the 64-bit half and [8, 27) for the high 64 bits.
+#define HASH_SECRET_WORDS        40
+#define HASH_SECRET_SCRAMBLE     24
+#define HASH_SECRET_LAST_STRIPE  25
+#define HASH_SECRET_MERGE_LOW    11
+#define HASH_SECRET_MERGE_HIGH   32
+#define HASH_SECRET_HIGH         8
+#define HASH_STRIPES_PER_BLOCK   16
+
+// the secret is splitmix64(0), splitmix64(1), ... (nothing up the sleeve)
+constexpr uint64 hash_secret_word(uint32 index) {
+    uint64 z = (uint64)(index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr uint64 hash_rotl64(uint64 x, uint32 r) {
+    return (x << r) | (x >> (64 - r));
+}
+constexpr uint64 hash_swap64(uint64 x) {
+    return ((x << 56) & 0xFF00000000000000ULL) | ((x << 40) & 0x00FF000000000000ULL) |
+           ((x << 24) & 0x0000FF0000000000ULL) | ((x <<  8) & 0x000000FF00000000ULL) |
+           ((x >>  8) & 0x00000000FF000000ULL) | ((x >> 24) & 0x0000000000FF0000ULL) |
+           ((x >> 40) & 0x000000000000FF00ULL) | ((x >> 56) & 0x00000000000000FFULL);
+}
+
+// multiplies out to 128 bits without any intrinsics, so it works in constexpr
+constexpr uint64 hash_mul128_fold_portable(uint64 a, uint64 b) {
+    uint64 lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    uint64 hi_lo = (a >> 32)        * (b & 0xFFFFFFFF);
+    uint64 lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+    uint64 hi_hi = (a >> 32)        * (b >> 32);
+
+    uint64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    uint64 upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    uint64 lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    return lower ^ upper;
+}
+
+constexpr uint64 hash_avalanche(uint64 h) {
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    return h ^ (h >> 32);
+}
+constexpr uint64 hash_avalanche_xxh64(uint64 h) {
+    h ^= h >> 33;
+    h *= HASH_PRIME64_2;
+    h ^= h >> 29;
+    h *= HASH_PRIME64_3;
+    return h ^ (h >> 32);
+}
+constexpr uint64 hash_rrmxmx(uint64 h, uint64 length) {
+    h ^= hash_rotl64(h, 49) ^ hash_rotl64(h, 24);
+    h *= 0x9FB21C651E98DF25ULL;
+    h ^= (h >> 35) + length;
+    h *= 0x9FB21C651E98DF25ULL;
+    return h ^ (h >> 28);
+}
+
+template <typename Ops>
+struct hash_impl {
+    typedef typename Ops::pointer pointer;
+
+    static constexpr uint64 len_0(uint64 seed, uint32 w) {
+        return hash_avalanche_xxh64(seed ^ Ops::secret(w) ^ Ops::secret(w + 1));
+    }
+
+    static constexpr uint64 len_1to3(pointer p, uint64 length, uint64 seed, uint32 w) {
+        uint32 c1 = Ops::read8(p, 0);
+        uint32 c2 = Ops::read8(p, length >> 1);
+        uint32 c3 = Ops::read8(p, length - 1);
+        uint32 combined = (c1 << 16) | (c2 << 24) | c3 | ((uint32)length << 8);
+        uint64 bitflip = (uint64)((uint32)Ops::secret(w) ^ (uint32)(Ops::secret(w) >> 32)) + seed;
+        return hash_avalanche_xxh64((uint64)combined ^ bitflip);
+    }
+
+    static constexpr uint64 len_4to8(pointer p, uint64 length, uint64 seed, uint32 w) {
+        uint64 input1 = Ops::read32(p, 0);
+        uint64 input2 = Ops::read32(p, length - 4);
+        uint64 bitflip = (Ops::secret(w + 1) ^ Ops::secret(w + 2)) - seed;
+        uint64 keyed = (input2 + (input1 << 32)) ^ bitflip;
+        return hash_rrmxmx(keyed, length);
+    }
+
+    static constexpr uint64 len_9to16(pointer p, uint64 length, uint64 seed, uint32 w) {
+        uint64 bitflip1 = (Ops::secret(w + 3) ^ Ops::secret(w + 4)) + seed;
+        uint64 bitflip2 = (Ops::secret(w + 5) ^ Ops::secret(w + 6)) - seed;
+        uint64 lo = Ops::read64(p, 0) ^ bitflip1;
+        uint64 hi = Ops::read64(p, length - 8) ^ bitflip2;
+        uint64 acc = length + hash_swap64(lo) + hi + Ops::mul128_fold(lo, hi);
+        return hash_avalanche(acc);
+    }
+
+    static constexpr uint64 mix16(pointer p, uint64 offset, uint64 seed, uint32 w) {
+        return Ops::mul128_fold(Ops::read64(p, offset)     ^ (Ops::secret(w)     + seed),
+                                Ops::read64(p, offset + 8) ^ (Ops::secret(w + 1) - seed));
+    }
+
+    static constexpr uint64 len_17to128(pointer p, uint64 length, uint64 seed, uint32 w) {
+        uint64 acc = length * HASH_PRIME64_1;
+        if (length > 32) {
+            if (length > 64) {
+                if (length > 96) {
+                    acc += mix16(p, 48, seed, w + 12);
+                    acc += mix16(p, length - 64, seed, w + 14);
+                }
+                acc += mix16(p, 32, seed, w + 8);
+                acc += mix16(p, length - 48, seed, w + 10);
+            }
+            acc += mix16(p, 16, seed, w + 4);
+            acc += mix16(p, length - 32, seed, w + 6);
+        }
+        acc += mix16(p, 0, seed, w);
+        acc += mix16(p, length - 16, seed, w + 2);
+        return hash_avalanche(acc);
+    }
+
+    static constexpr uint64 len_129to240(pointer p, uint64 length, uint64 seed, uint32 w) {
+        uint64 acc = length * HASH_PRIME64_1;
+        for (uint32 n = 0; n < 8; n++) {
+            acc += mix16(p, 16*n, seed, w + 2*n);
+        }
+        acc = hash_avalanche(acc);
+
+        uint32 num_chunks = (uint32)(length / 16);
+        for (uint32 n = 8; n < num_chunks; n++) {
+            acc += mix16(p, 16*n, seed, w + 2*(n - 8) + 1);
+        }
+        acc += mix16(p, length - 16, seed, w + 17);
+        return hash_avalanche(acc);
+    }
+
+    static constexpr uint64 short_hash(pointer p, uint64 length, uint64 seed, uint32 w) {
+        return (length == 0)   ? len_0(seed, w) :
+               (length <= 3)   ? len_1to3(p, length, seed, w) :
+               (length <= 8)   ? len_4to8(p, length, seed, w) :
+               (length <= 16)  ? len_9to16(p, length, seed, w) :
+               (length <= 128) ? len_17to128(p, length, seed, w) :
+                                 len_129to240(p, length, seed, w);
+    }
+
+    // long inputs. the runtime has SIMD versions of accumulate/scramble, these are the reference.
+    static constexpr void init_acc(uint64* acc, uint64 seed) {
+        acc[0] = HASH_PRIME32_3 + seed;
+        acc[1] = HASH_PRIME64_1 - seed;
+        acc[2] = HASH_PRIME64_2 + seed;
+        acc[3] = HASH_PRIME64_3 - seed;
+        acc[4] = HASH_PRIME64_4 + seed;
+        acc[5] = HASH_PRIME32_2 - seed;
+        acc[6] = HASH_PRIME64_5 + seed;
+        acc[7] = HASH_PRIME32_1 - seed;
+    }
+
+    static constexpr void accumulate_stripe(uint64* acc, pointer p, uint64 offset, uint32 w) {
+        for (uint32 n = 0; n < 8; n++) {
+            uint64 value = Ops::read64(p, offset + 8*n);
+            uint64 keyed = value ^ Ops::secret(w + n);
+            acc[n ^ 1] += value;
+            acc[n] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+        }
+    }
+
+    static constexpr void scramble(uint64* acc) {
+        for (uint32 n = 0; n < 8; n++) {
+            uint64 a = acc[n];
+            a ^= a >> 47;
+            a ^= Ops::secret(HASH_SECRET_SCRAMBLE + n);
+            acc[n] = a * HASH_PRIME32_1;
+        }
+    }
+
+    static constexpr uint64 merge(const uint64* acc, uint32 w, uint64 start) {
+        uint64 result = start;
+        for (uint32 n = 0; n < 4; n++) {
+            result += Ops::mul128_fold(acc[2*n] ^ Ops::secret(w + 2*n), acc[2*n + 1] ^ Ops::secret(w + 2*n + 1));
+        }
+        return hash_avalanche(result);
+    }
+
+    static constexpr void long_acc(uint64* acc, pointer p, uint64 length, uint64 seed) {
+        init_acc(acc, seed);
+
+        // every full stripe before the last byte. the last stripe is always the final 64 bytes
+        uint64 num_stripes = (length - 1) / HASH_STRIPE_SIZE;
+        for (uint64 n = 0; n < num_stripes; n++) {
+            uint32 index = (uint32)(n % HASH_STRIPES_PER_BLOCK);
+            accumulate_stripe(acc, p, n*HASH_STRIPE_SIZE, index);
+            if (index == HASH_STRIPES_PER_BLOCK - 1) {
+                scramble(acc);
+            }
+        }
+        accumulate_stripe(acc, p, length - HASH_STRIPE_SIZE, HASH_SECRET_LAST_STRIPE);
+    }
+};
+
+// constexpr reads from a char array
+struct hash_ops_const {
+    typedef const char* pointer;
+
+    static constexpr uint64 secret(uint32 index) {
+        return hash_secret_word(index);
+    }
+    static constexpr uint32 read8(pointer p, uint64 offset) {
+        return (uint8)p[offset];
+    }
+    static constexpr uint64 read32(pointer p, uint64 offset) {
+        return  (uint64)(uint8)p[offset]            | ((uint64)(uint8)p[offset + 1] << 8) |
+               ((uint64)(uint8)p[offset + 2] << 16) | ((uint64)(uint8)p[offset + 3] << 24);
+    }
+    static constexpr uint64 read64(pointer p, uint64 offset) {
+        return read32(p, offset) | (read32(p, offset + 4) << 32);
+    }
+    static constexpr uint64 mul128_fold(uint64 a, uint64 b) {
+        return hash_mul128_fold_portable(a, b);
+    }
+};
+
+constexpr uint64 hash_const64(const char* data, uint64 length, uint64 seed = 0) {
+    if (length <= HASH_MAX_SHORT_SIZE) {
+        return hash_impl<hash_ops_const>::short_hash(data, length, seed, 0);
+    }
+    uint64 acc[8] = {};
+    hash_impl<hash_ops_const>::long_acc(acc, data, length, seed);
+    return hash_impl<hash_ops_const>::merge(acc, HASH_SECRET_MERGE_LOW, length * HASH_PRIME64_1);
+}
+
+constexpr hash128 hash_const128(const char* data, uint64 length, uint64 seed = 0) {
+    hash128 result = {};
+    if (length <= HASH_MAX_SHORT_SIZE) {
+        result.low  = hash_impl<hash_ops_const>::short_hash(data, length, seed, 0);
+        result.high = hash_impl<hash_ops_const>::short_hash(data, length, seed, HASH_SECRET_HIGH);
+        return result;
+    }
+    uint64 acc[8] = {};
+    hash_impl<hash_ops_const>::long_acc(acc, data, length, seed);
+    result.low  = hash_impl<hash_ops_const>::merge(acc, HASH_SECRET_MERGE_LOW, length * HASH_PRIME64_1);
+    result.high = hash_impl<hash_ops_const>::merge(acc, HASH_SECRET_MERGE_HIGH, ~(length * HASH_PRIME64_2));
+    return result;
+}
+
+// hash of a string literal (without its null-terminator), always evaluated at compile time
+template <uint64 Value>
+struct hash_constant {
+    static const uint64 value = Value;
+};
+#define RH_HASH(Literal) (hash_constant<hash_const64(Literal, sizeof(Literal) - 1)>::value)
@@ -2,49 +2,58 @@
 
 #include "Core/Asserts.h"
 #include "Core/Logger.h"
+#include "Core/Logger_Binary.h"
 #include "Memory/Memory.h"
 #include "Memory/Memory_Arena.h"
 #include "Core/Event.h"
+#include "Core/Event_Listeners.h"
+#include "Core/Input_Actions.h"
+#include "Core/Input_Record.h"
 
 #include "Platform/Platform.h"
 
-// snapshot of a current keyboard state
-struct keyboard_state {
-    uint8 keys[KEY_MAX_KEYS];
-};
-
-// snapshot of current mouse state
+// snapshot of current mouse position
 struct mouse_state {
     int32 x_pos;
     int32 y_pos;
-    uint8 buttons[BUTTON_MAX_BUTTONS];
 };
 
 struct input_system_state {
-    keyboard_state keyboard_current;
-    keyboard_state keyboard_previous;
     mouse_state mouse_current;
     mouse_state mouse_previous;
 
     int32 mouse_raw_dx;
     int32 mouse_raw_dy;
+
+    // ring of transitions, indexed with a running count
+    input_transition transitions[INPUT_MAX_TRANSITIONS];
+    uint32 transition_write;
+    uint32 transition_frame_start;
+    bool32 transitions_overflowed;
+
+    // 0 means now
+    int64 arrival_time;
+    // earliest arrival of input not consumed by input_update() yet
+    int64 pending_timestamp;
 };
 
 global_variable input_system_state* global_input_state;
 
+input_keyboard_state global_input_keys;
+input_button_state global_input_buttons;
+
 bool32 input_init(struct memory_arena* arena) {
     global_input_state = PushStruct(arena, input_system_state);
     AssertMsg(global_input_state, "global_input_state is NULL");
 
-    for (uint16 n = 0; n < KEY_MAX_KEYS; n++) {
-        global_input_state->keyboard_current.keys[n] = 0;
-        global_input_state->keyboard_previous.keys[n] = 0;
-    }
+    memory_zero(&global_input_keys, sizeof(global_input_keys));
+    memory_zero(&global_input_buttons, sizeof(global_input_buttons));
 
-    for (uint16 n = 0; n < BUTTON_MAX_BUTTONS; n++) {
-        global_input_state->mouse_current.buttons[n] = 0;
-        global_input_state->mouse_previous.buttons[n] = 0;
-    }
+    global_input_state->transition_write = 0;
+    global_input_state->transition_frame_start = 0;
+    global_input_state->transitions_overflowed = false;
+    global_input_state->arrival_time = 0;
+    global_input_state->pending_timestamp = 0;
 
     return true;
 }
@@ -57,45 +66,147 @@ void input_update(real32 delta_time) {
 
     platform_update_mouse();
 
-    // swap previous and current input states
-    // actually perform a copy, so that state is persisted
-    memory_copy(&global_input_state->keyboard_previous, &global_input_state->keyboard_current, sizeof(keyboard_state));
-    memory_copy(&global_input_state->mouse_previous, &global_input_state->mouse_current, sizeof(mouse_state));
+    // current state becomes the previous one, and nothing has changed yet this frame
+    input_keyboard_state* keys = &global_input_keys;
+    for (uint32 n = 0; n < 4; n++) {
+        keys->previous.bits[n] = keys->down.bits[n];
+        keys->pressed.bits[n]  = 0;
+        keys->released.bits[n] = 0;
+    }
+    global_input_buttons.previous = global_input_buttons.down;
+    global_input_buttons.pressed  = 0;
+    global_input_buttons.released = 0;
+    global_input_state->mouse_previous = global_input_state->mouse_current;
 
     global_input_state->mouse_raw_dx = 0;
     global_input_state->mouse_raw_dy = 0;
 
+    // start a new frame of transitions
+    global_input_state->transition_frame_start = global_input_state->transition_write;
+    global_input_state->transitions_overflowed = false;
+
+    // this frame has seen everything that came in so far
+    global_input_state->pending_timestamp = 0;
+
+    input_actions_invalidate();
+    input_record_end_frame();
+
     // TODO: move mouse cursor to center of screen if captured
 }
 
+internal_func uint32 input_get_key_modifiers() {
+    // KEY_LSHIFT..KEY_RALT (0xA0-0xA5) are all in the same word
+    uint64 word = global_input_keys.down.bits[KEY_LSHIFT >> 6];
+
+    uint32 modifiers = KEY_MOD_NONE;
+    if (word & ((1ULL << (KEY_LSHIFT   & 63)) | (1ULL << (KEY_RSHIFT   & 63)))) modifiers |= KEY_MOD_SHIFT;
+    if (word & ((1ULL << (KEY_LCONTROL & 63)) | (1ULL << (KEY_RCONTROL & 63)))) modifiers |= KEY_MOD_CONTROL;
+    if (word & ((1ULL << (KEY_LALT     & 63)) | (1ULL << (KEY_RALT     & 63)))) modifiers |= KEY_MOD_ALT;
+
+    return modifiers;
+}
+
+// stamps a piece of input, and keeps track of the oldest one not consumed yet
+internal_func int64 input_mark_arrival() {
+    input_system_state* state = global_input_state;
+    int64 timestamp = state->arrival_time ? state->arrival_time : platform_get_wall_clock();
+    if (state->pending_timestamp == 0 || timestamp < state->pending_timestamp) {
+        state->pending_timestamp = timestamp;
+    }
+    return timestamp;
+}
+
+void input_set_arrival_time(int64 timestamp) {
+    AssertMsg(global_input_state, "global_input_state is NULL");
+    global_input_state->arrival_time = timestamp;
+}
+int64 input_get_pending_timestamp() {
+    AssertMsg(global_input_state, "global_input_state is NULL");
+    return global_input_state->pending_timestamp;
+}
+
+internal_func void input_record_transition(input_transition_type type, uint16 code, uint8 pressed) {
+    input_system_state* state = global_input_state;
+
+    if (state->transition_write - state->transition_frame_start >= INPUT_MAX_TRANSITIONS) {
+        // drop the oldest one from this frame
+        state->transition_frame_start++;
+        if (!state->transitions_overflowed) {
+            RH_WARN_CH(LOG_CHANNEL_INPUT, "More than %d input transitions in one frame, dropping the oldest!", INPUT_MAX_TRANSITIONS);
+            state->transitions_overflowed = true;
+        }
+    }
+
+    input_transition* transition = &state->transitions[state->transition_write & (INPUT_MAX_TRANSITIONS - 1)];
+    transition->timestamp = input_mark_arrival();
+    transition->code      = code;
+    transition->type      = (uint8)type;
+    transition->pressed   = pressed ? 1 : 0;
+    state->transition_write++;
+}
+
 // internal functions to respond to key events
 void input_process_key(keyboard_keys key, uint8 pressed) {
     AssertMsg(global_input_state, "global_input_state is NULL");
+    if (!input_record_call(INPUT_RECORD_KEY, key, pressed)) {
+        return;
+    }
 
-    // only if the state has changed since last call/update
-    if (global_input_state->keyboard_current.keys[key] != pressed) {
-        global_input_state->keyboard_current.keys[key] = pressed;
+    input_keyboard_state* keys = &global_input_keys;
+    uint32 word = key >> 6;
+    uint64 bit = 1ULL << (key & 63);
 
-        event_context data;
-        data.u16[0] = (uint16)key;
-        event_fire((uint16)(pressed ? EVENT_CODE_KEY_PRESSED : EVENT_CODE_KEY_RELEASED), 0, data);
+    // only if the state has changed since last call/update
+    if (((keys->down.bits[word] & bit) != 0) != (pressed != 0)) {
+        keys->down.bits[word] ^= bit;
+        keys->pressed.bits[word]  = keys->down.bits[word] & ~keys->previous.bits[word];
+        keys->released.bits[word] = keys->previous.bits[word] & ~keys->down.bits[word];
+        input_actions_invalidate();
+        input_record_transition(INPUT_TRANSITION_KEY, (uint16)key, pressed);
+
+        if (pressed) {
+            event_key_pressed event = { key, input_get_key_modifiers() };
+            event_fire_typed(event);
+        } else {
+            event_key_released event = { key, input_get_key_modifiers() };
+            event_fire_typed(event);
+        }
     }
 }
 
 void input_process_mouse_button(mouse_button_codes button, uint8 pressed) {
     AssertMsg(global_input_state, "global_input_state is NULL");
+    if (!input_record_call(INPUT_RECORD_MOUSE_BUTTON, button, pressed)) {
+        return;
+    }
 
-    // only if the state has changed since last call/update
-    if (global_input_state->mouse_current.buttons[button] != pressed) {
-        global_input_state->mouse_current.buttons[button] = pressed;
+    input_button_state* buttons = &global_input_buttons;
+    uint32 bit = 1u << button;
 
-        event_context data;
-        data.u16[0] = (uint16)button;
-        event_fire((uint16)(pressed ? EVENT_CODE_BUTTON_PRESSED : EVENT_CODE_BUTTON_RELEASED), 0, data);
+    // only if the state has changed since last call/update
+    if (((buttons->down & bit) != 0) != (pressed != 0)) {
+        buttons->down ^= bit;
+        buttons->pressed  = buttons->down & ~buttons->previous;
+        buttons->released = buttons->previous & ~buttons->down;
+        input_actions_invalidate();
+        input_record_transition(INPUT_TRANSITION_BUTTON, (uint16)button, pressed);
+
+        int32 mouse_x = global_input_state->mouse_current.x_pos;
+        int32 mouse_y = global_input_state->mouse_current.y_pos;
+        if (pressed) {
+            event_button_pressed event = { button, mouse_x, mouse_y };
+            event_fire_typed(event);
+        } else {
+            event_button_released event = { button, mouse_x, mouse_y };
+            event_fire_typed(event);
+        }
     }
 }
 void input_process_mouse_move(int32 mouse_x, int32 mouse_y) {
     AssertMsg(global_input_state, "global_input_state is NULL");
+    if (!input_record_call(INPUT_RECORD_MOUSE_MOVE, mouse_x, mouse_y)) {
+        return;
+    }
 
     // only if the state has changed since last call/update
     if (global_input_state->mouse_current.x_pos != mouse_x || 
@@ -103,84 +214,111 @@ void input_process_mouse_move(int32 mouse_x, int32 mouse_y) {
 
         global_input_state->mouse_current.x_pos = mouse_x;
         global_input_state->mouse_current.y_pos = mouse_y;
+        input_mark_arrival();
 
-        //RH_TRACE("Mouse x: %d", mouse_x);
+        RH_TRACE_BIN_CH(LOG_CHANNEL_INPUT, "Mouse x: %d", mouse_x);
 
-        event_context data;
-        data.i32[0] = mouse_x;
-        data.i32[1] = mouse_y;
-        event_fire(EVENT_CODE_MOUSE_MOVED, 0, data);
+        event_mouse_moved event = { mouse_x, mouse_y };
+        event_fire_typed(event);
     }
 }
 void input_process_raw_mouse_move(int32 mouse_dx, int32 mouse_dy) {
     AssertMsg(global_input_state, "global_input_state is NULL");
+    if (!input_record_call(INPUT_RECORD_RAW_MOUSE_MOVE, mouse_dx, mouse_dy)) {
+        return;
+    }
 
     global_input_state->mouse_raw_dx += mouse_dx;
     global_input_state->mouse_raw_dy += mouse_dy;
+    input_mark_arrival();
 }
 
 void input_process_mouse_wheel(int32 mouse_z) {
     AssertMsg(global_input_state, "global_input_state is NULL");
+    if (!input_record_call(INPUT_RECORD_MOUSE_WHEEL, mouse_z, 0)) {
+        return;
+    }
 
-    event_context data;
-    data.i32[0] = mouse_z;
-    event_fire(EVENT_CODE_MOUSE_WHEEL, 0, data);
-}
+    input_mark_arrival();
 
-// ask for the state of keys
-// Key down is true!
-// Up is false!
-RHAPI bool32 input_is_key_down(keyboard_keys key) {
-    AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->keyboard_current.keys[key] == true;
+    event_mouse_wheel event = { mouse_z };
+    event_fire_typed(event);
 }
-RHAPI bool32 input_is_key_up(keyboard_keys key) {
+
+void input_get_mouse_pos(int32* x, int32* y) {
     AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->keyboard_current.keys[key] == false;
+    *x = global_input_state->mouse_current.x_pos;
+    *y = global_input_state->mouse_current.y_pos;
 }
-RHAPI bool32 input_was_key_down(keyboard_keys key) {
+void input_get_prev_mouse_pos(int32* x, int32* y) {
     AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->keyboard_previous.keys[key] == true;
+    *x = global_input_state->mouse_previous.x_pos;
+    *y = global_input_state->mouse_previous.y_pos;
 }
-RHAPI bool32 input_was_key_up(keyboard_keys key) {
+void input_get_raw_mouse_offset(int32* dx, int32* dy) {
     AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->keyboard_previous.keys[key] == false;
+    *dx = global_input_state->mouse_raw_dx;
+    *dy = global_input_state->mouse_raw_dy;
 }
 
-// ask for state of mouse
-// Key down is true!
-// Up is false!
-RHAPI bool32 input_is_button_down(mouse_button_codes button) {
+uint32 input_get_num_transitions() {
     AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->mouse_current.buttons[button] == true;
+    return global_input_state->transition_write - global_input_state->transition_frame_start;
 }
-RHAPI bool32 input_is_button_up(mouse_button_codes button) {
+const input_transition* input_get_transition(uint32 index) {
     AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->mouse_current.buttons[button] == false;
+    AssertMsg(index < input_get_num_transitions(), "Transition index out of range");
+
+    uint32 slot = (global_input_state->transition_frame_start + index) & (INPUT_MAX_TRANSITIONS - 1);
+    return &global_input_state->transitions[slot];
 }
-RHAPI bool32 input_was_button_down(mouse_button_codes button) {
+
+internal_func uint32 input_count_transitions(input_transition_type type, uint16 code, uint8 pressed) {
     AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->mouse_previous.buttons[button] == true;
+    input_system_state* state = global_input_state;
+
+    uint32 count = 0;
+    for (uint32 n = state->transition_frame_start; n != state->transition_write; n++) {
+        const input_transition* transition = &state->transitions[n & (INPUT_MAX_TRANSITIONS - 1)];
+        if (transition->type == type && transition->code == code && transition->pressed == pressed) {
+            count++;
+        }
+    }
+    return count;
 }
-RHAPI bool32 input_was_button_up(mouse_button_codes button) {
+
+internal_func bool32 input_first_press_time(input_transition_type type, uint16 code, int64* timestamp) {
     AssertMsg(global_input_state, "global_input_state is NULL");
-    return (bool)global_input_state->mouse_previous.buttons[button] == false;
+    input_system_state* state = global_input_state;
+
+    for (uint32 n = state->transition_frame_start; n != state->transition_write; n++) {
+        const input_transition* transition = &state->transitions[n & (INPUT_MAX_TRANSITIONS - 1)];
+        if (transition->type == type && transition->code == code && transition->pressed) {
+            *timestamp = transition->timestamp;
+            return true;
+        }
+    }
+    return false;
 }
 
-void input_get_mouse_pos(int32* x, int32* y) {
-    AssertMsg(global_input_state, "global_input_state is NULL");
-    *x = global_input_state->mouse_current.x_pos;
-    *y = global_input_state->mouse_current.y_pos;
+uint32 input_get_key_press_count(keyboard_keys key) {
+    return input_count_transitions(INPUT_TRANSITION_KEY, (uint16)key, 1);
 }
-void input_get_prev_mouse_pos(int32* x, int32* y) {
-    AssertMsg(global_input_state, "global_input_state is NULL");
-    *x = global_input_state->mouse_previous.x_pos;
-    *y = global_input_state->mouse_previous.y_pos;
+uint32 input_get_key_release_count(keyboard_keys key) {
+    return input_count_transitions(INPUT_TRANSITION_KEY, (uint16)key, 0);
 }
-void input_get_raw_mouse_offset(int32* dx, int32* dy) {
-    AssertMsg(global_input_state, "global_input_state is NULL");
-    *dx = global_input_state->mouse_raw_dx;
-    *dy = global_input_state->mouse_raw_dy;
+uint32 input_get_button_press_count(mouse_button_codes button) {
+    return input_count_transitions(INPUT_TRANSITION_BUTTON, (uint16)button, 1);
+}
+uint32 input_get_button_release_count(mouse_button_codes button) {
+    return input_count_transitions(INPUT_TRANSITION_BUTTON, (uint16)button, 0);
+}
+
+bool32 input_get_key_press_time(keyboard_keys key, int64* timestamp) {
+    return input_first_press_time(INPUT_TRANSITION_KEY, (uint16)key, timestamp);
+}
+bool32 input_get_button_press_time(mouse_button_codes button, int64* timestamp) {
+    return input_first_press_time(INPUT_TRANSITION_BUTTON, (uint16)button, timestamp);
 }
 
 RHAPI const char* input_get_key_string(keyboard_keys key) {
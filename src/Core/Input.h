@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Defines.h"
+#include "Core/Bits.h"
 
 enum mouse_button_codes {
     BUTTON_LEFT = 0,
@@ -128,24 +129,92 @@ enum keyboard_keys {
     KEY_MAX_KEYS = 0xFF
 };
 
+/*
+ * Key/button state:
+ *   Kept as bit masks, one bit per keyboard_keys/mouse_button_codes value.
+ *   pressed/released are the keys that went down/up since the last input_update()
+ *   (down & ~previous, previous & ~down), so "which keys changed" is a couple of
+ *   bit scans instead of a loop over every key.
+ *
+ *   The state lives in a plain global so the accessors below can be inlined bit tests.
+ * */
+struct input_key_mask {
+    uint64 bits[4];
+};
+
+inline bool32 key_mask_test(const input_key_mask& mask, uint32 index) {
+    return (bool32)((mask.bits[index >> 6] >> (index & 63)) & 1);
+}
+inline bool32 key_mask_any(const input_key_mask& mask) {
+    return (mask.bits[0] | mask.bits[1] | mask.bits[2] | mask.bits[3]) != 0;
+}
+inline input_key_mask key_mask_or(const input_key_mask& a, const input_key_mask& b) {
+    input_key_mask result = { { a.bits[0] | b.bits[0], a.bits[1] | b.bits[1], a.bits[2] | b.bits[2], a.bits[3] | b.bits[3] } };
+    return result;
+}
+
+// pops the lowest set bit into *index. returns false once the mask is empty
+//   input_key_mask pressed = input_get_keys_pressed();
+//   uint32 key;
+//   while (key_mask_next(&pressed, &key)) { ... }
+inline bool32 key_mask_next(input_key_mask* mask, uint32* index) {
+    for (uint32 word = 0; word < 4; word++) {
+        if (mask->bits[word]) {
+            *index = (word << 6) + bit_scan_forward64(mask->bits[word]);
+            mask->bits[word] &= mask->bits[word] - 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct input_button_state {
+    uint32 down;
+    uint32 previous;
+    uint32 pressed;
+    uint32 released;
+};
+
+struct input_keyboard_state {
+    input_key_mask down;
+    input_key_mask previous;
+    input_key_mask pressed;
+    input_key_mask released;
+};
+
+RHAPI extern input_keyboard_state global_input_keys;
+RHAPI extern input_button_state global_input_buttons;
+
 bool32 input_init(struct memory_arena* arena);
 void input_shutdown();
 
 void input_update(real32 delta_time);
 
 // ask for the state of keys
-RHAPI bool32 input_is_key_down(keyboard_keys key);
-RHAPI bool32 input_is_key_up(keyboard_keys key);
-RHAPI bool32 input_was_key_down(keyboard_keys key);
-RHAPI bool32 input_was_key_up(keyboard_keys key);
+inline bool32 input_is_key_down(keyboard_keys key)  { return  key_mask_test(global_input_keys.down, key); }
+inline bool32 input_is_key_up(keyboard_keys key)    { return !key_mask_test(global_input_keys.down, key); }
+inline bool32 input_was_key_down(keyboard_keys key) { return  key_mask_test(global_input_keys.previous, key); }
+inline bool32 input_was_key_up(keyboard_keys key)   { return !key_mask_test(global_input_keys.previous, key); }
+
+// went down/up since the last input_update()
+inline bool32 input_is_key_pressed(keyboard_keys key)  { return key_mask_test(global_input_keys.pressed, key); }
+inline bool32 input_is_key_released(keyboard_keys key) { return key_mask_test(global_input_keys.released, key); }
+
+inline input_key_mask input_get_keys_down()     { return global_input_keys.down; }
+inline input_key_mask input_get_keys_pressed()  { return global_input_keys.pressed; }
+inline input_key_mask input_get_keys_released() { return global_input_keys.released; }
+inline input_key_mask input_get_keys_changed()  { return key_mask_or(global_input_keys.pressed, global_input_keys.released); }
 
 void input_process_key(keyboard_keys key, uint8 pressed);
 
 // ask for state of mouse
-RHAPI bool32 input_is_button_down(mouse_button_codes button);
-RHAPI bool32 input_is_button_up(mouse_button_codes button);
-RHAPI bool32 input_was_button_down(mouse_button_codes button);
-RHAPI bool32 input_was_button_up(mouse_button_codes button);
+inline bool32 input_is_button_down(mouse_button_codes button)  { return  (global_input_buttons.down     >> button) & 1; }
+inline bool32 input_is_button_up(mouse_button_codes button)    { return !((global_input_buttons.down     >> button) & 1); }
+inline bool32 input_was_button_down(mouse_button_codes button) { return  (global_input_buttons.previous >> button) & 1; }
+inline bool32 input_was_button_up(mouse_button_codes button)   { return !((global_input_buttons.previous >> button) & 1); }
+
+inline bool32 input_is_button_pressed(mouse_button_codes button)  { return (global_input_buttons.pressed  >> button) & 1; }
+inline bool32 input_is_button_released(mouse_button_codes button) { return (global_input_buttons.released >> button) & 1; }
 
 RHAPI void input_get_mouse_pos(int32* x, int32* y);
 RHAPI void input_get_prev_mouse_pos(int32* x, int32* y);
@@ -157,4 +226,54 @@ void input_process_mouse_wheel(int32 mouse_z);
 
 void input_process_raw_mouse_move(int32 mouse_dx, int32 mouse_dy);
 
-RHAPI const char* input_get_key_string(keyboard_keys key);
\ No newline at end of file
+RHAPI const char* input_get_key_string(keyboard_keys key);
+
+/*
+ * Input transitions:
+ *   Every key/button state change is also recorded with its wall clock timestamp,
+ *   so presses shorter than a frame aren't lost, and timing isn't rounded to the frame.
+ *
+ *   "This frame" is everything since the last input_update(). The ring holds
+ *   INPUT_MAX_TRANSITIONS, if more than that come in during a frame the oldest are dropped.
+ * */
+#define INPUT_MAX_TRANSITIONS 256 // must be a power of 2
+
+enum input_transition_type {
+    INPUT_TRANSITION_KEY = 0,
+    INPUT_TRANSITION_BUTTON,
+};
+
+struct input_transition {
+    int64 timestamp; // platform_get_wall_clock() when it arrived
+    uint16 code;     // keyboard_keys or mouse_button_codes
+    uint8 type;      // input_transition_type
+    uint8 pressed;
+};
+
+// transitions this frame, oldest first
+RHAPI uint32 input_get_num_transitions();
+RHAPI const input_transition* input_get_transition(uint32 index);
+
+// how many times it went down/up this frame
+RHAPI uint32 input_get_key_press_count(keyboard_keys key);
+RHAPI uint32 input_get_key_release_count(keyboard_keys key);
+RHAPI uint32 input_get_button_press_count(mouse_button_codes button);
+RHAPI uint32 input_get_button_release_count(mouse_button_codes button);
+
+// timestamp of the first press this frame. returns false if it wasn't pressed this frame
+RHAPI bool32 input_get_key_press_time(keyboard_keys key, int64* timestamp);
+RHAPI bool32 input_get_button_press_time(mouse_button_codes button, int64* timestamp);
+/*
+ * Input arrival time:
+ *   The platform layer can tell the input system when the input it's about to process
+ *   actually arrived (e.g. when the OS queued the message), since that can be well before
+ *   the frame gets around to processing it. Without that, input is stamped when processed.
+ *
+ *   The earliest arrival time of input that no frame has consumed yet is kept until
+ *   input_update(), which marks everything up to then as consumed. The renderer draws with
+ *   it, to measure input latency (see Core/Input_Latency.h).
+ * */
+// 0 goes back to stamping input when it's processed
+void input_set_arrival_time(int64 timestamp);
+// 0 if nothing new came in since the last input_update()
+RHAPI int64 input_get_pending_timestamp();
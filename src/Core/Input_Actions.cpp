@@ -0,0 +1,337 @@
+#include "Input_Actions.h"
+
+#include "Core/Asserts.h"
+#include "Core/Logger.h"
+#include "Core/Hash.h"
+#include "Core/Tokenizer.h"
+#include "Memory/Memory.h"
+
+#include "Platform/Platform.h"
+
+struct input_action_tables {
+    // which actions/axis each code drives. axis is stored +1, so 0 is none
+    uint64 key_actions[256];
+    uint64 button_actions[BUTTON_MAX_BUTTONS];
+    uint8  key_axis[256];
+    uint8  button_axis[BUTTON_MAX_BUTTONS];
+    real32 key_axis_scale[256];
+    real32 button_axis_scale[BUTTON_MAX_BUTTONS];
+
+    uint32 num_actions;
+    uint32 num_axes;
+    uint64 action_hashes[INPUT_MAX_ACTIONS];
+    uint64 axis_hashes[INPUT_MAX_AXES];
+    char   action_names[INPUT_MAX_ACTIONS][INPUT_MAX_ACTION_NAME];
+    char   axis_names[INPUT_MAX_AXES][INPUT_MAX_ACTION_NAME];
+};
+
+struct input_action_state {
+    input_action_tables tables;
+
+    // evaluated from the input masks
+    bool32 dirty;
+    uint64 actions_down;
+    uint64 actions_pressed;
+    uint64 actions_released;
+    real32 axis_values[INPUT_MAX_AXES];
+};
+
+global_variable input_action_state global_action_state;
+
+void input_actions_invalidate() {
+    global_action_state.dirty = true;
+}
+
+// ORs together the action masks of every key set in keys
+internal_func uint64 input_gather_key_actions(const input_action_tables* tables, input_key_mask keys) {
+    uint64 actions = 0;
+    uint32 key;
+    while (key_mask_next(&keys, &key)) {
+        actions |= tables->key_actions[key];
+    }
+    return actions;
+}
+internal_func uint64 input_gather_button_actions(const input_action_tables* tables, uint32 buttons) {
+    uint64 actions = 0;
+    while (buttons) {
+        actions |= tables->button_actions[bit_scan_forward(buttons)];
+        buttons &= buttons - 1;
+    }
+    return actions;
+}
+
+// ORs together the action masks of every key/button that went down (pressed) or up at least
+// once this frame, from the same transitions as input_get_*_press_count(). That catches a
+// press and release inside one frame, which the down/previous masks can't see
+internal_func void input_gather_transition_actions(const input_action_tables* tables, uint64* pressed, uint64* released) {
+    uint32 num_transitions = input_get_num_transitions();
+    for (uint32 n = 0; n < num_transitions; n++) {
+        const input_transition* transition = input_get_transition(n);
+
+        uint64 actions = 0;
+        if (transition->type == INPUT_TRANSITION_KEY) {
+            actions = tables->key_actions[transition->code & 0xFF];
+        } else if (transition->code < BUTTON_MAX_BUTTONS) {
+            actions = tables->button_actions[transition->code];
+        }
+
+        if (transition->pressed) {
+            *pressed |= actions;
+        } else {
+            *released |= actions;
+        }
+    }
+}
+
+internal_func void input_actions_evaluate() {
+    input_action_state* state = &global_action_state;
+    const input_action_tables* tables = &state->tables;
+    state->dirty = false;
+
+    uint64 down     = input_gather_key_actions(tables, global_input_keys.down)     | input_gather_button_actions(tables, global_input_buttons.down);
+    uint64 previous = input_gather_key_actions(tables, global_input_keys.previous) | input_gather_button_actions(tables, global_input_buttons.previous);
+    uint64 pressed  = down & ~previous;
+    uint64 released = previous & ~down;
+    input_gather_transition_actions(tables, &pressed, &released);
+    state->actions_down     = down;
+    state->actions_pressed  = pressed;
+    state->actions_released = released;
+
+    for (uint32 n = 0; n < tables->num_axes; n++) {
+        state->axis_values[n] = 0.0f;
+    }
+    input_key_mask keys = global_input_keys.down;
+    uint32 key;
+    while (key_mask_next(&keys, &key)) {
+        if (tables->key_axis[key]) {
+            state->axis_values[tables->key_axis[key] - 1] += tables->key_axis_scale[key];
+        }
+    }
+    for (uint32 button = 0; button < BUTTON_MAX_BUTTONS; button++) {
+        if (tables->button_axis[button] && ((global_input_buttons.down >> button) & 1)) {
+            state->axis_values[tables->button_axis[button] - 1] += tables->button_axis_scale[button];
+        }
+    }
+    for (uint32 n = 0; n < tables->num_axes; n++) {
+        real32 value = state->axis_values[n];
+        state->axis_values[n] = (value > 1.0f) ? 1.0f : ((value < -1.0f) ? -1.0f : value);
+    }
+}
+
+inline void input_actions_refresh() {
+    if (global_action_state.dirty) {
+        input_actions_evaluate();
+    }
+}
+
+bool32 input_action_down(uint32 action) {
+    input_actions_refresh();
+    return (action < INPUT_MAX_ACTIONS) && ((global_action_state.actions_down >> action) & 1);
+}
+bool32 input_action_pressed(uint32 action) {
+    input_actions_refresh();
+    return (action < INPUT_MAX_ACTIONS) && ((global_action_state.actions_pressed >> action) & 1);
+}
+bool32 input_action_released(uint32 action) {
+    input_actions_refresh();
+    return (action < INPUT_MAX_ACTIONS) && ((global_action_state.actions_released >> action) & 1);
+}
+real32 input_axis_value(uint32 axis) {
+    input_actions_refresh();
+    return (axis < global_action_state.tables.num_axes) ? global_action_state.axis_values[axis] : 0.0f;
+}
+
+// name lookup
+internal_func uint32 input_find_name(const uint64* hashes, char (*names)[INPUT_MAX_ACTION_NAME], uint32 count, string_view name) {
+    uint64 hash = hash_bytes64(name.data, name.length);
+    for (uint32 n = 0; n < count; n++) {
+        if (hashes[n] == hash && string_equals(make_string_view(names[n]), name)) {
+            return n;
+        }
+    }
+    return INPUT_INVALID_ACTION;
+}
+
+uint32 input_find_action(const char* name) {
+    input_action_tables* tables = &global_action_state.tables;
+    return input_find_name(tables->action_hashes, tables->action_names, tables->num_actions, make_string_view(name));
+}
+uint32 input_find_axis(const char* name) {
+    input_action_tables* tables = &global_action_state.tables;
+    return input_find_name(tables->axis_hashes, tables->axis_names, tables->num_axes, make_string_view(name));
+}
+
+// finds a name, or adds it. returns INPUT_INVALID_ACTION if there's no room
+internal_func uint32 input_add_name(uint64* hashes, char (*names)[INPUT_MAX_ACTION_NAME], uint32* count, uint32 max_count, string_view name) {
+    uint32 index = input_find_name(hashes, names, *count, name);
+    if (index != INPUT_INVALID_ACTION) {
+        return index;
+    }
+    if (*count == max_count || name.length >= INPUT_MAX_ACTION_NAME) {
+        return INPUT_INVALID_ACTION;
+    }
+
+    index = (*count)++;
+    hashes[index] = hash_bytes64(name.data, name.length);
+    memory_copy(names[index], name.data, name.length);
+    names[index][name.length] = 0;
+    return index;
+}
+
+internal_func bool32 input_parse_key(string_view name, uint32* key) {
+    // the names are the debug strings, so just look for a match
+    if (string_equals(name, make_string_view("undefined"))) {
+        return false;
+    }
+    for (uint32 n = 1; n < KEY_MAX_KEYS; n++) {
+        if (string_equals(name, make_string_view(input_get_key_string((keyboard_keys)n)))) {
+            *key = n;
+            return true;
+        }
+    }
+    return false;
+}
+internal_func bool32 input_parse_button(string_view name, uint32* button) {
+    const char* button_names[BUTTON_MAX_BUTTONS] = { "left", "right", "middle", "mouse4", "mouse5" };
+    for (uint32 n = 0; n < BUTTON_MAX_BUTTONS; n++) {
+        if (string_equals(name, make_string_view(button_names[n]))) {
+            *button = n;
+            return true;
+        }
+    }
+    return false;
+}
+
+internal_func uint32 input_config_line_number(string_view config, const char* position) {
+    uint32 line = 1;
+    for (const char* scan = config.data; scan < position; scan++) {
+        if (*scan == '\n') {
+            line++;
+        }
+    }
+    return line;
+}
+
+bool32 input_actions_compile(string_view config) {
+    // build into a copy, so a bad config doesn't leave half of its bindings behind
+    input_action_tables* tables = (input_action_tables*)platform_alloc(sizeof(input_action_tables), 0);
+    if (!tables) {
+        return false;
+    }
+
+    text_tokenizer tokenizer;
+    tokenizer_init(&tokenizer, config);
+
+    bool32 success = true;
+    string_view token;
+    while (tokenizer_next_token(&tokenizer, &token)) {
+        if (token.data[0] == '#') {
+            tokenizer_skip_line(&tokenizer);
+            continue;
+        }
+        const char* line_start = token.data;
+
+        bool32 is_axis = string_equals(token, make_string_view("axis"));
+        if (!is_axis && !string_equals(token, make_string_view("action"))) {
+            RH_ERROR_CH(LOG_CHANNEL_INPUT, "Input config line %u: expected 'action' or 'axis', got '%.*s'",
+                        input_config_line_number(config, line_start), (int)token.length, token.data);
+            success = false;
+            break;
+        }
+
+        string_view name, device, code_name;
+        if (!tokenizer_next_token_on_line(&tokenizer, &name) ||
+            !tokenizer_next_token_on_line(&tokenizer, &device) ||
+            !tokenizer_next_token_on_line(&tokenizer, &code_name)) {
+            RH_ERROR_CH(LOG_CHANNEL_INPUT, "Input config line %u: expected '%s <name> key|button <code>'",
+                        input_config_line_number(config, line_start), is_axis ? "axis" : "action");
+            success = false;
+            break;
+        }
+
+        bool32 is_button = string_equals(device, make_string_view("button"));
+        uint32 code = 0;
+        bool32 valid_code = is_button ? input_parse_button(code_name, &code) :
+                            string_equals(device, make_string_view("key")) && input_parse_key(code_name, &code);
+        if (!valid_code) {
+            RH_ERROR_CH(LOG_CHANNEL_INPUT, "Input config line %u: unknown %.*s '%.*s'",
+                        input_config_line_number(config, line_start),
+                        (int)device.length, device.data, (int)code_name.length, code_name.data);
+            success = false;
+            break;
+        }
+
+        if (is_axis) {
+            real32 scale;
+            if (!tokenizer_next_float(&tokenizer, &scale)) {
+                RH_ERROR_CH(LOG_CHANNEL_INPUT, "Input config line %u: axis binding needs a scale",
+                            input_config_line_number(config, line_start));
+                success = false;
+                break;
+            }
+
+            uint32 axis = input_add_name(tables->axis_hashes, tables->axis_names, &tables->num_axes, INPUT_MAX_AXES, name);
+            if (axis == INPUT_INVALID_ACTION) {
+                RH_ERROR_CH(LOG_CHANNEL_INPUT, "Input config line %u: too many axes, or the name is too long (max %d, %d chars)",
+                            input_config_line_number(config, line_start), INPUT_MAX_AXES, INPUT_MAX_ACTION_NAME - 1);
+                success = false;
+                break;
+            }
+
+            uint8*  axis_table  = is_button ? tables->button_axis : tables->key_axis;
+            real32* scale_table = is_button ? tables->button_axis_scale : tables->key_axis_scale;
+            if (axis_table[code] && axis_table[code] != axis + 1) {
+                RH_WARN_CH(LOG_CHANNEL_INPUT, "Input config line %u: '%.*s' already drives axis '%s', rebinding it",
+                           input_config_line_number(config, line_start), (int)code_name.length, code_name.data,
+                           tables->axis_names[axis_table[code] - 1]);
+            }
+            axis_table[code]  = (uint8)(axis + 1);
+            scale_table[code] = scale;
+        } else {
+            uint32 action = input_add_name(tables->action_hashes, tables->action_names, &tables->num_actions, INPUT_MAX_ACTIONS, name);
+            if (action == INPUT_INVALID_ACTION) {
+                RH_ERROR_CH(LOG_CHANNEL_INPUT, "Input config line %u: too many actions, or the name is too long (max %d, %d chars)",
+                            input_config_line_number(config, line_start), INPUT_MAX_ACTIONS, INPUT_MAX_ACTION_NAME - 1);
+                success = false;
+                break;
+            }
+
+            if (is_button) {
+                tables->button_actions[code] |= 1ULL << action;
+            } else {
+                tables->key_actions[code] |= 1ULL << action;
+            }
+        }
+
+        // only a comment can come after a binding
+        string_view extra;
+        if (tokenizer_next_token_on_line(&tokenizer, &extra) && extra.data[0] != '#') {
+            RH_ERROR_CH(LOG_CHANNEL_INPUT, "Input config line %u: unexpected '%.*s'",
+                        input_config_line_number(config, line_start), (int)extra.length, extra.data);
+            success = false;
+            break;
+        }
+        tokenizer_skip_line(&tokenizer);
+    }
+
+    if (success) {
+        memory_copy(&global_action_state.tables, tables, sizeof(input_action_tables));
+        global_action_state.dirty = true;
+        RH_INFO_CH(LOG_CHANNEL_INPUT, "Compiled %u input actions and %u axes.", tables->num_actions, tables->num_axes);
+    }
+
+    platform_free(tables);
+    return success;
+}
+
+bool32 input_actions_load(const char* full_path) {
+    mapped_file file;
+    if (!platform_map_file(full_path, &file, PLATFORM_MAP_SEQUENTIAL)) {
+        RH_WARN_CH(LOG_CHANNEL_INPUT, "Input config '%s' is missing or unreadable.", full_path);
+        return false;
+    }
+
+    bool32 result = input_actions_compile(make_string_view((const char*)file.data, file.num_bytes));
+    platform_unmap_file(&file);
+    return result;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/Input.h"
+#include "Core/String.h"
+
+/*
+ * Input actions:
+ *   Gameplay asks about named actions ("jump") and axes ("move_x") instead of raw keys.
+ *   Bindings come from a text config, and compile into flat tables indexed by key and
+ *   button code: a bitmask of the actions each code triggers, and the axis it drives.
+ *
+ *   All actions are evaluated at once from the input bit masks (a bit scan over the keys
+ *   that are down) and this frame's transitions, the first time anything asks after the
+ *   input changed. That's
+ *   once per frame in practice; each query after that is a bit test.
+ *
+ *   Config format, one binding per line, '#' starts a comment:
+ *       action <name> key <key>              key names are the ones from input_get_key_string()
+ *       action <name> button <button>        left, right, middle, mouse4, mouse5
+ *       axis   <name> key <key> <scale>      the axis value is the sum of the scales of
+ *       axis   <name> button <button> <scale>   everything held down, clamped to [-1, 1]
+ *
+ *   An action can have any number of bindings. A key can trigger any number of actions,
+ *   but only drive one axis.
+ * */
+
+#define INPUT_MAX_ACTIONS     64 // one bit each in a uint64
+#define INPUT_MAX_AXES        16
+#define INPUT_MAX_ACTION_NAME 32
+#define INPUT_INVALID_ACTION  0xFFFFFFFF
+
+// replaces every binding. returns false (and keeps the old bindings) if the config has errors
+RHAPI bool32 input_actions_compile(string_view config);
+RHAPI bool32 input_actions_load(const char* full_path);
+
+// ids stay valid until the next compile/load. INPUT_INVALID_ACTION if there's no such name
+RHAPI uint32 input_find_action(const char* name);
+RHAPI uint32 input_find_axis(const char* name);
+
+// invalid ids are never down
+RHAPI bool32 input_action_down(uint32 action);
+// any of its bindings went down/up since the last input_update(), even if it went
+// back again in the same frame
+RHAPI bool32 input_action_pressed(uint32 action);
+RHAPI bool32 input_action_released(uint32 action);
+RHAPI real32 input_axis_value(uint32 axis);
+
+// called by the input system whenever key/button state changes
+void input_actions_invalidate();
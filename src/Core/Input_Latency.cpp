@@ -0,0 +1,146 @@
+#include "Input_Latency.h"
+
+#include "Core/Logger.h"
+#include "Core/Percentile.h"
+#include "Memory/Memory.h"
+#include "Platform/Platform.h"
+
+struct input_latency_state {
+    // last INPUT_LATENCY_WINDOW samples, indexed with a running count
+    real32 window[INPUT_LATENCY_WINDOW];
+    uint32 window_write;
+
+    // whole run
+    uint32 histogram[INPUT_LATENCY_NUM_BUCKETS];
+    uint32 num_samples;
+    uint32 num_frames;
+    real64 sum_ms;
+    real32 min_ms;
+    real32 max_ms;
+    real32 last_ms;
+};
+
+global_variable input_latency_state global_latency_state;
+
+void input_latency_frame_presented(int64 input_timestamp, int64 present_timestamp) {
+    input_latency_state* state = &global_latency_state;
+    state->num_frames++;
+    if (input_timestamp == 0) {
+        return;
+    }
+
+    real32 ms = (real32)(1000.0 * platform_get_seconds_elapsed(input_timestamp, present_timestamp));
+    if (ms < 0.0f) {
+        ms = 0.0f;
+    }
+
+    state->window[state->window_write & (INPUT_LATENCY_WINDOW - 1)] = ms;
+    state->window_write++;
+
+    uint32 bucket = (uint32)(ms / INPUT_LATENCY_BUCKET_MS);
+    if (bucket >= INPUT_LATENCY_NUM_BUCKETS) {
+        bucket = INPUT_LATENCY_NUM_BUCKETS - 1;
+    }
+    state->histogram[bucket]++;
+
+    if (state->num_samples == 0 || ms < state->min_ms) state->min_ms = ms;
+    if (state->num_samples == 0 || ms > state->max_ms) state->max_ms = ms;
+    state->num_samples++;
+    state->sum_ms += ms;
+    state->last_ms = ms;
+}
+
+// partially sorts values so that values[k] is the k-th smallest, and returns it
+internal_func real32 input_latency_select(real32* values, uint32 count, uint32 k) {
+    uint32 lo = 0;
+    uint32 hi = count - 1;
+    while (lo < hi) {
+        real32 pivot = values[lo + (hi - lo) / 2];
+        uint32 i = lo;
+        uint32 j = hi;
+        while (i <= j) {
+            while (values[i] < pivot) i++;
+            while (values[j] > pivot) j--;
+            if (i <= j) {
+                real32 tmp = values[i];
+                values[i] = values[j];
+                values[j] = tmp;
+                i++;
+                if (j == 0) break;
+                j--;
+            }
+        }
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+    return values[k];
+}
+
+void input_latency_get_recent(input_latency_stats* stats) {
+    input_latency_state* state = &global_latency_state;
+    memory_zero(stats, sizeof(input_latency_stats));
+    stats->num_frames = state->num_frames;
+
+    uint32 count = (state->window_write < INPUT_LATENCY_WINDOW) ? state->window_write : INPUT_LATENCY_WINDOW;
+    if (count == 0) {
+        return;
+    }
+
+    real32 values[INPUT_LATENCY_WINDOW];
+    real64 sum = 0.0;
+    real32 min = state->window[0];
+    real32 max = state->window[0];
+    for (uint32 n = 0; n < count; n++) {
+        real32 value = state->window[n];
+        values[n] = value;
+        sum += value;
+        if (value < min) min = value;
+        if (value > max) max = value;
+    }
+
+    stats->num_samples = count;
+    stats->last_ms = state->last_ms;
+    stats->min_ms  = min;
+    stats->max_ms  = max;
+    stats->mean_ms = (real32)(sum / (real64)count);
+    stats->p99_ms  = input_latency_select(values, count, p99_rank(count));
+}
+
+void input_latency_get_total(input_latency_stats* stats) {
+    input_latency_state* state = &global_latency_state;
+    memory_zero(stats, sizeof(input_latency_stats));
+    stats->num_frames = state->num_frames;
+    if (state->num_samples == 0) {
+        return;
+    }
+
+    stats->num_samples = state->num_samples;
+    stats->last_ms = state->last_ms;
+    stats->min_ms  = state->min_ms;
+    stats->max_ms  = state->max_ms;
+    stats->mean_ms = (real32)(state->sum_ms / (real64)state->num_samples);
+    stats->p99_ms  = p99_from_histogram(state->histogram, INPUT_LATENCY_NUM_BUCKETS, INPUT_LATENCY_BUCKET_MS,
+                                        state->num_samples, state->max_ms);
+}
+
+void input_latency_reset() {
+    memory_zero(&global_latency_state, sizeof(global_latency_state));
+}
+
+void input_latency_log_report() {
+    input_latency_stats stats;
+    input_latency_get_total(&stats);
+    if (stats.num_samples == 0) {
+        RH_INFO_CH(LOG_CHANNEL_INPUT, "Input latency: no input over %u frames.", stats.num_frames);
+        return;
+    }
+
+    RH_INFO_CH(LOG_CHANNEL_INPUT, "Input latency over %u frames with input (%u total): "
+               "min %.2f ms, mean %.2f ms, p99 %.2f ms, max %.2f ms",
+               stats.num_samples, stats.num_frames, stats.min_ms, stats.mean_ms, stats.p99_ms, stats.max_ms);
+}
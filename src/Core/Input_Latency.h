@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * Input latency:
+ *   Measures how long input waits before a frame that saw it is presented.
+ *
+ *   The input system remembers the arrival time of the oldest input no frame has consumed
+ *   yet (input_get_pending_timestamp()). The renderer carries that timestamp with the frame
+ *   it draws, and reports it back here once the frame is presented. A frame's latency is
+ *   present time - input arrival time. Frames without new input don't produce a sample.
+ *
+ *   "Presented" is when the present call returns. For the swapchain that's when the frame
+ *   is queued for the display, for the null renderer it's right away. So this is the part
+ *   of the latency the engine controls, not the display's scanout.
+ *
+ *   Recent stats cover the last INPUT_LATENCY_WINDOW samples. Total stats cover the whole
+ *   run, with the p99 taken from a histogram in INPUT_LATENCY_BUCKET_MS steps.
+ * */
+
+#define INPUT_LATENCY_WINDOW      512 // must be a power of 2
+#define INPUT_LATENCY_BUCKET_MS   0.1f
+#define INPUT_LATENCY_NUM_BUCKETS 2000 // latencies over 200ms all land in the last bucket
+
+struct input_latency_stats {
+    uint32 num_samples;
+    uint32 num_frames; // frames presented, with or without input
+    real32 last_ms;
+    real32 min_ms;
+    real32 mean_ms;
+    real32 p99_ms;
+    real32 max_ms;
+};
+
+// called by the renderer after each present. input_timestamp is 0 if the frame had no new input
+RHAPI void input_latency_frame_presented(int64 input_timestamp, int64 present_timestamp);
+
+// all zero if there are no samples yet
+RHAPI void input_latency_get_recent(input_latency_stats* stats);
+RHAPI void input_latency_get_total(input_latency_stats* stats);
+RHAPI void input_latency_reset();
+
+// logs the total stats
+RHAPI void input_latency_log_report();
@@ -0,0 +1,219 @@
+#include "Input_Record.h"
+
+#include "Core/Input.h"
+#include "Core/Logger.h"
+#include "Memory/Memory.h"
+#include "Platform/Platform.h"
+
+#define INPUT_RECORD_MAGIC   0x4E494852 // 'RHIN'
+#define INPUT_RECORD_VERSION 1
+
+struct input_record_header {
+    uint32 magic;
+    uint32 version;
+    uint64 num_entries;
+    uint32 num_frames;
+    uint32 pad;
+};
+
+// 16 bytes. a/b are the arguments of the input_process_* call
+struct input_record_entry {
+    uint32 frame;
+    uint32 type;
+    int32  a;
+    int32  b;
+};
+
+struct input_record_state {
+    bool32 recording;
+    bool32 playing;
+    bool32 feeding; // true while playback is calling into the input system
+    uint32 frame_index;
+
+    // recording
+    input_record_entry* entries;
+    uint64 max_entries;
+    uint64 num_entries;
+    bool32 overflowed;
+
+    // playback
+    mapped_file playback_file;
+    uint32 playback_num_frames;
+    const input_record_entry* playback_scan;
+    const input_record_entry* playback_end;
+};
+
+global_variable input_record_state global_record_state;
+
+bool32 input_record_start(uint64 max_bytes) {
+    input_record_state* state = &global_record_state;
+    if (state->recording) {
+        RH_WARN_CH(LOG_CHANNEL_INPUT, "Already recording input!");
+        return false;
+    }
+
+    // header goes in front of the entries when it's written out
+    state->max_entries = max_bytes / sizeof(input_record_entry);
+    state->entries = (input_record_entry*)platform_alloc(sizeof(input_record_header) + state->max_entries*sizeof(input_record_entry), 0);
+    if (!state->entries) {
+        RH_ERROR_CH(LOG_CHANNEL_INPUT, "Could not allocate %llu bytes for the input recording!", max_bytes);
+        return false;
+    }
+    state->entries = (input_record_entry*)((uint8*)state->entries + sizeof(input_record_header));
+
+    state->num_entries = 0;
+    state->overflowed  = false;
+    state->frame_index = 0;
+    state->recording   = true;
+
+    RH_INFO_CH(LOG_CHANNEL_INPUT, "Recording input.");
+    return true;
+}
+
+bool32 input_record_stop(const char* full_path) {
+    input_record_state* state = &global_record_state;
+    if (!state->recording) {
+        return false;
+    }
+    state->recording = false;
+
+    input_record_header* header = (input_record_header*)state->entries - 1;
+    header->magic       = INPUT_RECORD_MAGIC;
+    header->version     = INPUT_RECORD_VERSION;
+    header->num_entries = state->num_entries;
+    header->num_frames  = state->frame_index;
+    header->pad         = 0;
+
+    uint64 num_bytes = sizeof(input_record_header) + state->num_entries*sizeof(input_record_entry);
+    bool32 result = platform_write_entire_file(full_path, header, num_bytes);
+    if (result) {
+        RH_INFO_CH(LOG_CHANNEL_INPUT, "Wrote %llu input calls over %u frames to '%s'", state->num_entries, state->frame_index, full_path);
+    } else {
+        RH_ERROR_CH(LOG_CHANNEL_INPUT, "Failed to write input recording to '%s'", full_path);
+    }
+
+    platform_free(header);
+    state->entries = nullptr;
+    state->max_entries = 0;
+    state->num_entries = 0;
+
+    return result;
+}
+
+bool32 input_record_is_recording() {
+    return global_record_state.recording;
+}
+
+bool32 input_record_call(input_record_type type, int32 a, int32 b) {
+    input_record_state* state = &global_record_state;
+    if (state->playing && !state->feeding) {
+        return false; // live input is ignored during playback
+    }
+    if (!state->recording) {
+        return true;
+    }
+
+    if (state->num_entries == state->max_entries) {
+        if (!state->overflowed) {
+            RH_WARN_CH(LOG_CHANNEL_INPUT, "Input recording is full after %llu calls, no longer recording!", state->num_entries);
+            state->overflowed = true;
+        }
+        return true;
+    }
+
+    input_record_entry* entry = &state->entries[state->num_entries++];
+    entry->frame = state->frame_index;
+    entry->type  = (uint32)type;
+    entry->a     = a;
+    entry->b     = b;
+    return true;
+}
+
+void input_record_end_frame() {
+    global_record_state.frame_index++;
+}
+
+bool32 input_playback_start(const char* full_path) {
+    input_record_state* state = &global_record_state;
+    if (state->playing) {
+        input_playback_stop();
+    }
+
+    // played straight out of the page cache. prefaulted, so playback never waits on the disk mid-run
+    if (!platform_map_file(full_path, &state->playback_file, PLATFORM_MAP_SEQUENTIAL | PLATFORM_MAP_PREFAULT) ||
+        state->playback_file.num_bytes < sizeof(input_record_header)) {
+        RH_ERROR_CH(LOG_CHANNEL_INPUT, "Could not read input recording '%s'", full_path);
+        platform_unmap_file(&state->playback_file);
+        return false;
+    }
+
+    const input_record_header* header = (const input_record_header*)state->playback_file.data;
+    uint64 max_entries = (state->playback_file.num_bytes - sizeof(input_record_header)) / sizeof(input_record_entry);
+    if (header->magic != INPUT_RECORD_MAGIC || header->version != INPUT_RECORD_VERSION || header->num_entries > max_entries) {
+        RH_ERROR_CH(LOG_CHANNEL_INPUT, "'%s' is not a version %d input recording!", full_path, INPUT_RECORD_VERSION);
+        platform_unmap_file(&state->playback_file);
+        return false;
+    }
+
+    state->playback_scan = (const input_record_entry*)(header + 1);
+    state->playback_end  = state->playback_scan + header->num_entries;
+    state->playback_num_frames = header->num_frames;
+    state->frame_index   = 0;
+    state->playing       = true;
+
+    RH_INFO_CH(LOG_CHANNEL_INPUT, "Playing back %llu input calls over %u frames from '%s'", header->num_entries, header->num_frames, full_path);
+    return true;
+}
+
+void input_playback_stop() {
+    input_record_state* state = &global_record_state;
+    if (!state->playing) {
+        return;
+    }
+
+    platform_unmap_file(&state->playback_file);
+    state->playback_scan = nullptr;
+    state->playback_end  = nullptr;
+    state->playing       = false;
+}
+
+bool32 input_playback_is_playing() {
+    return global_record_state.playing;
+}
+
+void input_playback_frame() {
+    input_record_state* state = &global_record_state;
+    if (!state->playing) {
+        return;
+    }
+
+    state->feeding = true;
+    while (state->playback_scan < state->playback_end && state->playback_scan->frame <= state->frame_index) {
+        const input_record_entry* entry = state->playback_scan++;
+        switch (entry->type) {
+            case INPUT_RECORD_KEY: {
+                if ((uint32)entry->a < KEY_MAX_KEYS) {
+                    input_process_key((keyboard_keys)entry->a, (uint8)entry->b);
+                }
+            } break;
+            case INPUT_RECORD_MOUSE_BUTTON: {
+                if ((uint32)entry->a < BUTTON_MAX_BUTTONS) {
+                    input_process_mouse_button((mouse_button_codes)entry->a, (uint8)entry->b);
+                }
+            } break;
+            case INPUT_RECORD_MOUSE_MOVE:     input_process_mouse_move(entry->a, entry->b);     break;
+            case INPUT_RECORD_RAW_MOUSE_MOVE: input_process_raw_mouse_move(entry->a, entry->b); break;
+            case INPUT_RECORD_MOUSE_WHEEL:    input_process_mouse_wheel(entry->a);              break;
+            default: {
+                RH_WARN_CH(LOG_CHANNEL_INPUT, "Unknown input recording entry type %u, skipping it.", entry->type);
+            } break;
+        }
+    }
+    state->feeding = false;
+
+    // keep going (ignoring live input) until the last recorded frame
+    if (state->playback_scan == state->playback_end && state->frame_index + 1 >= state->playback_num_frames) {
+        RH_INFO_CH(LOG_CHANNEL_INPUT, "Input playback finished on frame %u", state->frame_index);
+        input_playback_stop();
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * Input recording:
+ *   Records every input_process_* call (keys, buttons, mouse moves, raw mouse moves,
+ *   wheel), tagged with the input frame it happened in, and plays a recording back
+ *   into the input system on a later run. A frame is everything between two calls to
+ *   input_update().
+ *
+ *   While playing back, input coming from the platform layer is ignored, so a run
+ *   sees exactly the recorded input. That way a performance scenario can be replayed
+ *   identically without a window or a person at the keyboard.
+ * */
+
+RHAPI bool32 input_record_start(uint64 max_bytes);
+// writes the recording to full_path. returns false if nothing could be written
+RHAPI bool32 input_record_stop(const char* full_path);
+RHAPI bool32 input_record_is_recording();
+
+RHAPI bool32 input_playback_start(const char* full_path);
+RHAPI void   input_playback_stop();
+RHAPI bool32 input_playback_is_playing();
+
+// feeds the recorded calls for the current frame into the input system
+RHAPI void input_playback_frame();
+
+// used by Input.cpp
+enum input_record_type {
+    INPUT_RECORD_KEY = 0,
+    INPUT_RECORD_MOUSE_BUTTON,
+    INPUT_RECORD_MOUSE_MOVE,
+    INPUT_RECORD_RAW_MOUSE_MOVE,
+    INPUT_RECORD_MOUSE_WHEEL,
+};
+// records the call, if recording. returns false if live input should be ignored (during playback)
+bool32 input_record_call(input_record_type type, int32 a, int32 b);
+// advances the frame index. called from input_update()
+void input_record_end_frame();
@@ -0,0 +1,158 @@
+#include "Job_Benchmark.h"
+
+#include "Core/Job_System.h"
+#include "Core/Logger.h"
+#include "Platform/Platform.h"
+
+#define JOB_BENCH_NUM_EMPTY     65536
+#define JOB_BENCH_GROUP         1024 // empty jobs pushed per job_run
+#define JOB_BENCH_NUM_FOR_CALLS 4096
+#define JOB_BENCH_NUM_CHUNKS    2048 // jobs the cpu-bound work is split into
+#define JOB_BENCH_CHUNK_ROUNDS  20000
+#define JOB_BENCH_REPEATS       3 // best of
+
+struct job_bench_chunks {
+    uint32 results[JOB_BENCH_NUM_CHUNKS];
+    job_decl decls[JOB_BENCH_NUM_CHUNKS];
+};
+
+internal_func void job_bench_empty(void* data) {
+}
+
+internal_func void job_bench_empty_range(uint64 begin, uint64 end, void* data) {
+}
+
+// a few tens of microseconds of arithmetic that can't be skipped
+internal_func void job_bench_chunk(void* data) {
+    uint32* result = (uint32*)data;
+    uint32 x = *result | 1;
+    for (uint32 n = 0; n < JOB_BENCH_CHUNK_ROUNDS; n++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+    *result = x;
+}
+
+internal_func real64 job_bench_empty_jobs() {
+    job_decl decls[JOB_BENCH_GROUP];
+    for (uint32 n = 0; n < JOB_BENCH_GROUP; n++) {
+        decls[n].func = job_bench_empty;
+        decls[n].data = nullptr;
+    }
+
+    real64 best = 0.0;
+    for (uint32 repeat = 0; repeat < JOB_BENCH_REPEATS; repeat++) {
+        int64 start = platform_get_wall_clock();
+        for (uint32 n = 0; n < JOB_BENCH_NUM_EMPTY; n += JOB_BENCH_GROUP) {
+            job_counter counter = {};
+            job_run(decls, JOB_BENCH_GROUP, &counter);
+            job_wait(&counter);
+        }
+        real64 seconds = platform_get_seconds_elapsed(start, platform_get_wall_clock());
+        if (repeat == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    return 1.0e9 * best / (real64)JOB_BENCH_NUM_EMPTY;
+}
+
+internal_func real64 job_bench_parallel_for() {
+    uint64 count = (uint64)job_system_num_workers() * JOB_BATCHES_PER_WORKER;
+
+    real64 best = 0.0;
+    for (uint32 repeat = 0; repeat < JOB_BENCH_REPEATS; repeat++) {
+        int64 start = platform_get_wall_clock();
+        for (uint32 n = 0; n < JOB_BENCH_NUM_FOR_CALLS; n++) {
+            job_parallel_for(count, 1, job_bench_empty_range, nullptr);
+        }
+        real64 seconds = platform_get_seconds_elapsed(start, platform_get_wall_clock());
+        if (repeat == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    return 1.0e6 * best / (real64)JOB_BENCH_NUM_FOR_CALLS;
+}
+
+internal_func real64 job_bench_work(job_bench_chunks* chunks) {
+    real64 best = 0.0;
+    for (uint32 repeat = 0; repeat < JOB_BENCH_REPEATS; repeat++) {
+        for (uint32 n = 0; n < JOB_BENCH_NUM_CHUNKS; n++) {
+            chunks->results[n] = n;
+            chunks->decls[n].func = job_bench_chunk;
+            chunks->decls[n].data = &chunks->results[n];
+        }
+
+        int64 start = platform_get_wall_clock();
+        job_counter counter = {};
+        job_run(chunks->decls, JOB_BENCH_NUM_CHUNKS, &counter);
+        job_wait(&counter);
+        real64 seconds = platform_get_seconds_elapsed(start, platform_get_wall_clock());
+        if (repeat == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    return 1000.0 * best;
+}
+
+void job_benchmark_run(uint32 max_workers) {
+    uint32 num_physical = platform_get_num_physical_cores();
+    if (max_workers == 0) {
+        max_workers = num_physical;
+    }
+    if (max_workers > JOB_MAX_WORKERS) {
+        max_workers = JOB_MAX_WORKERS;
+    }
+
+    job_system_stats stats;
+    job_system_get_stats(&stats);
+    uint32 restore_workers = stats.num_workers;
+    job_system_shutdown();
+
+    job_bench_chunks* chunks = (job_bench_chunks*)platform_alloc(sizeof(job_bench_chunks), 0);
+    if (!chunks) {
+        RH_ERROR("Could not allocate the job benchmark");
+        return;
+    }
+
+    RH_INFO("Job benchmark: %u physical cores, %u logical. %u jobs of %u rounds of work",
+            num_physical, platform_get_num_logical_cores(), JOB_BENCH_NUM_CHUNKS, JOB_BENCH_CHUNK_ROUNDS);
+
+    real64 single_worker_ms = 0.0;
+    uint32 num_workers = 1;
+    for (;;) {
+        if (!job_system_init(num_workers)) {
+            break;
+        }
+
+        real64 empty_ns = job_bench_empty_jobs();
+        real64 for_us   = job_bench_parallel_for();
+
+        job_system_stats before;
+        job_system_get_stats(&before);
+        real64 work_ms = job_bench_work(chunks);
+        job_system_stats after;
+        job_system_get_stats(&after);
+        uint64 num_executed = after.num_executed - before.num_executed;
+        uint64 num_stolen   = after.num_stolen   - before.num_stolen;
+
+        if (num_workers == 1) {
+            single_worker_ms = work_ms;
+        }
+        real64 speedup = (work_ms > 0.0) ? single_worker_ms / work_ms : 0.0;
+        RH_INFO("  %2u workers: %6.1f ns/job, %6.2f us/parallel_for, work %8.2f ms, speedup %5.2fx, efficiency %5.1f%%, %5.1f%% stolen",
+                num_workers, empty_ns, for_us, work_ms, speedup, 100.0 * speedup / (real64)num_workers,
+                num_executed ? 100.0 * (real64)num_stolen / (real64)num_executed : 0.0);
+
+        job_system_shutdown();
+        if (num_workers == max_workers) {
+            break;
+        }
+        num_workers = (num_workers*2 < max_workers) ? num_workers*2 : max_workers;
+    }
+
+    platform_free(chunks);
+    if (restore_workers) {
+        job_system_init(restore_workers);
+    }
+}
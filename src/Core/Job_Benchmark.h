@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * Job system benchmark:
+ *   Restarts the job system (Core/Job_System.h) with 1, 2, 4... up to max_workers workers,
+ *   and logs for each:
+ *     - the cost of a job: pushing, taking and running empty jobs, per job
+ *     - the cost of a job_parallel_for over a few trivial items, per call
+ *     - speedup and efficiency on a fixed amount of cpu-bound work split into small jobs,
+ *       against running it on 1 worker
+ *
+ *   max_workers of 0 goes up to one per physical core. Call it from the thread that owns
+ *   the job system; it's left running with the same number of workers it had before
+ *   (or stopped, if it wasn't running).
+ * */
+
+RHAPI void job_benchmark_run(uint32 max_workers);
@@ -0,0 +1,513 @@
+#include "Job_System.h"
+
+#include "Core/Logger.h"
+#include "Core/Asserts.h"
+#include "Memory/Memory.h"
+#include "Memory/Memory_Arena.h"
+#include "Platform/Platform.h"
+
+#include <new>
+
+// rounds of stealing attempts before an idle worker goes to sleep
+#define JOB_SPIN_ROUNDS 64
+// sleeping workers wake up this often even if nothing signals them
+#define JOB_SLEEP_MS 10
+// job_wait gives up its time slice after this many empty rounds, in case the jobs
+// it's waiting on are running on a thread that isn't scheduled
+#define JOB_WAIT_YIELD_ROUNDS 256
+
+#define JOB_INVALID_WORKER 0xFFFFFFFF
+
+struct job {
+    job_func func;
+    void* data;
+    job_counter* counter;
+
+    // set while the job is queued. cleared once a worker has taken it, so the slot can be reused
+    std::atomic<uint32> busy;
+};
+
+// Chase-Lev work-stealing deque with a fixed size.
+// the owner pushes and pops at bottom, thieves take from top
+struct job_deque {
+    std::atomic<job*> slots[JOB_QUEUE_SIZE];
+
+    // keep owner/thief positions on separate cache lines
+    uint8 pad0[64];
+    std::atomic<int64> top;
+    uint8 pad1[64];
+    std::atomic<int64> bottom;
+    uint8 pad2[64];
+};
+
+struct job_worker {
+    job_deque deque;
+
+    // only touched by the owner
+    job pool[JOB_QUEUE_SIZE];
+    uint32 next_job;
+    uint32 rng;
+
+    std::atomic<uint64> num_executed;
+    std::atomic<uint64> num_stolen;
+    std::atomic<uint64> num_inline;
+    uint8 pad0[64];
+};
+
+struct job_system {
+    job_worker* workers;
+    uint32 num_workers;
+
+    std::atomic<uint32> running;
+    std::atomic<uint32> num_sleeping;
+    void* wake; // semaphore the sleeping workers wait on
+    void* threads[JOB_MAX_WORKERS];
+};
+global_variable job_system* global_job_system;
+
+// which worker the calling thread is
+global_variable thread_local uint32 job_worker_index = JOB_INVALID_WORKER;
+
+// owner only. false if the deque is full
+internal_func bool32 job_deque_push(job_deque* deque, job* new_job) {
+    int64 bottom = deque->bottom.load(std::memory_order_relaxed);
+    int64 top = deque->top.load(std::memory_order_acquire);
+    if (bottom - top >= JOB_QUEUE_SIZE) {
+        return false;
+    }
+
+    deque->slots[bottom & (JOB_QUEUE_SIZE - 1)].store(new_job, std::memory_order_relaxed);
+    deque->bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+}
+
+// owner only. takes the newest job, racing thieves for the last one
+internal_func job* job_deque_pop(job_deque* deque) {
+    int64 bottom = deque->bottom.load(std::memory_order_relaxed) - 1;
+    deque->bottom.store(bottom, std::memory_order_seq_cst);
+    int64 top = deque->top.load(std::memory_order_seq_cst);
+
+    if (top > bottom) {
+        // empty
+        deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    job* popped = deque->slots[bottom & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        if (!deque->top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst)) {
+            popped = nullptr; // a thief got it
+        }
+        deque->bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return popped;
+}
+
+// any thread. takes the oldest job, nullptr if empty or another thread got there first
+internal_func job* job_deque_steal(job_deque* deque) {
+    int64 top = deque->top.load(std::memory_order_seq_cst);
+    int64 bottom = deque->bottom.load(std::memory_order_seq_cst);
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    job* stolen = deque->slots[top & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+    if (!deque->top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst)) {
+        return nullptr;
+    }
+    return stolen;
+}
+
+internal_func uint32 job_random(job_worker* worker) {
+    // xorshift32
+    uint32 x = worker->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    worker->rng = x;
+    return x;
+}
+
+// own deque first, then everyone else's starting from a random one
+internal_func job* job_find(job_system* system, uint32 worker_index, bool32* was_stolen) {
+    job_worker* worker = &system->workers[worker_index];
+    job* found = job_deque_pop(&worker->deque);
+    if (found) {
+        *was_stolen = false;
+        return found;
+    }
+
+    uint32 num_workers = system->num_workers;
+    uint32 start = job_random(worker) % num_workers;
+    for (uint32 n = 0; n < num_workers; n++) {
+        uint32 victim = (start + n) % num_workers;
+        if (victim == worker_index) {
+            continue;
+        }
+        found = job_deque_steal(&system->workers[victim].deque);
+        if (found) {
+            *was_stolen = true;
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+internal_func void job_execute(job_system* system, uint32 worker_index, job* taken, bool32 was_stolen) {
+    job_func func = taken->func;
+    void* data = taken->data;
+    job_counter* counter = taken->counter;
+    taken->busy.store(0, std::memory_order_release);
+
+    func(data);
+    if (counter) {
+        counter->value.fetch_sub(1, std::memory_order_release);
+    }
+
+    job_worker* worker = &system->workers[worker_index];
+    worker->num_executed.fetch_add(1, std::memory_order_relaxed);
+    if (was_stolen) {
+        worker->num_stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+internal_func bool32 job_try_execute(job_system* system, uint32 worker_index) {
+    bool32 was_stolen = false;
+    job* found = job_find(system, worker_index, &was_stolen);
+    if (found) {
+        job_execute(system, worker_index, found, was_stolen);
+        return true;
+    }
+    return false;
+}
+
+internal_func uint32 job_worker_thread(void* data) {
+    job_system* system = global_job_system;
+    uint32 worker_index = (uint32)((job_worker*)data - system->workers);
+    job_worker_index = worker_index;
+
+    while (system->running.load(std::memory_order_acquire)) {
+        if (job_try_execute(system, worker_index)) {
+            continue;
+        }
+
+        bool32 found = false;
+        for (uint32 round = 0; round < JOB_SPIN_ROUNDS && !found; round++) {
+            platform_cpu_pause();
+            found = job_try_execute(system, worker_index);
+        }
+        if (found) {
+            continue;
+        }
+
+        // say we're going to sleep before the last look, so a job pushed after
+        // that look sees us sleeping and wakes us up
+        system->num_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        if (!job_try_execute(system, worker_index) && system->running.load(std::memory_order_acquire)) {
+            platform_wait_semaphore(system->wake, JOB_SLEEP_MS);
+        }
+        system->num_sleeping.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    return 0;
+}
+
+bool32 job_system_init(uint32 num_workers) {
+    AssertMsg(!global_job_system, "job_system_init called twice!");
+
+    if (num_workers == 0) {
+        num_workers = platform_get_num_physical_cores();
+    }
+    if (num_workers > JOB_MAX_WORKERS) {
+        num_workers = JOB_MAX_WORKERS;
+    }
+
+    // construct the atomics in place, the memory comes back zeroed but unconstructed
+    void* memory = platform_alloc(sizeof(job_system), 0);
+    if (!memory) {
+        RH_ERROR("Could not allocate the job system");
+        return false;
+    }
+    job_system* system = new (memory) job_system;
+    system->workers = (job_worker*)platform_alloc(num_workers * sizeof(job_worker), 0);
+    system->wake = platform_create_semaphore(0, num_workers);
+    if (!system->workers || !system->wake) {
+        RH_ERROR("Could not create the job system");
+        if (system->wake) {
+            platform_destroy_semaphore(system->wake);
+        }
+        platform_free(system->workers);
+        platform_free(system);
+        return false;
+    }
+
+    system->num_workers = num_workers;
+    system->running.store(1);
+    system->num_sleeping.store(0);
+    for (uint32 n = 0; n < num_workers; n++) {
+        job_worker* worker = new (&system->workers[n]) job_worker;
+        for (uint32 slot = 0; slot < JOB_QUEUE_SIZE; slot++) {
+            worker->deque.slots[slot].store(nullptr, std::memory_order_relaxed);
+            worker->pool[slot].busy.store(0, std::memory_order_relaxed);
+        }
+        worker->deque.top.store(0);
+        worker->deque.bottom.store(0);
+        worker->next_job = 0;
+        worker->rng = 0x9E3779B9u * (n + 1);
+        worker->num_executed.store(0, std::memory_order_relaxed);
+        worker->num_stolen.store(0, std::memory_order_relaxed);
+        worker->num_inline.store(0, std::memory_order_relaxed);
+    }
+
+    global_job_system = system;
+    job_worker_index = 0;
+
+    // worker 0 is this thread
+    for (uint32 n = 1; n < num_workers; n++) {
+        system->threads[n] = platform_create_thread(job_worker_thread, &system->workers[n]);
+        if (!system->threads[n]) {
+            RH_ERROR("Could not create job worker thread %u", n);
+            system->num_workers = n;
+            break;
+        }
+    }
+
+    RH_INFO("Job system started with %u workers (%u physical cores, %u logical)",
+            system->num_workers, platform_get_num_physical_cores(), platform_get_num_logical_cores());
+    return true;
+}
+
+void job_system_shutdown() {
+    job_system* system = global_job_system;
+    if (!system) {
+        return;
+    }
+    AssertMsg(job_worker_index == 0, "job_system_shutdown has to be called from the thread that started it!");
+
+    system->running.store(0, std::memory_order_release);
+    for (uint32 n = 1; n < system->num_workers; n++) {
+        platform_signal_semaphore(system->wake);
+    }
+    for (uint32 n = 1; n < system->num_workers; n++) {
+        platform_join_thread(system->threads[n]);
+    }
+
+    // nobody else is left to take them, so the deques can all be drained from here.
+    // leftover jobs can push more jobs (onto worker 0, maybe after it was drained),
+    // so keep going until a whole pass finds nothing
+    uint32 num_leftover = 0;
+    for (;;) {
+        uint32 num_found = 0;
+        for (uint32 n = 0; n < system->num_workers; n++) {
+            job* leftover;
+            while ((leftover = job_deque_steal(&system->workers[n].deque)) != nullptr) {
+                job_execute(system, 0, leftover, false);
+                num_found++;
+            }
+        }
+        if (num_found == 0) {
+            break;
+        }
+        num_leftover += num_found;
+    }
+    if (num_leftover) {
+        RH_DEBUG("Ran %u leftover jobs at shutdown", num_leftover);
+    }
+
+    platform_destroy_semaphore(system->wake);
+    platform_free(system->workers);
+    platform_free(system);
+    global_job_system = nullptr;
+    job_worker_index = JOB_INVALID_WORKER;
+}
+
+uint32 job_system_num_workers() {
+    return global_job_system ? global_job_system->num_workers : 1;
+}
+
+void job_system_get_stats(job_system_stats* stats) {
+    memory_zero(stats, sizeof(job_system_stats));
+    job_system* system = global_job_system;
+    if (!system) {
+        return;
+    }
+
+    stats->num_workers = system->num_workers;
+    for (uint32 n = 0; n < system->num_workers; n++) {
+        job_worker* worker = &system->workers[n];
+        stats->num_executed += worker->num_executed.load(std::memory_order_relaxed);
+        stats->num_stolen   += worker->num_stolen.load(std::memory_order_relaxed);
+        stats->num_inline   += worker->num_inline.load(std::memory_order_relaxed);
+    }
+}
+
+void job_run(const job_decl* jobs, uint32 num_jobs, job_counter* counter) {
+    if (num_jobs == 0) {
+        return;
+    }
+    job_system* system = global_job_system;
+    uint32 worker_index = job_worker_index;
+    AssertMsg(!system || worker_index < system->num_workers, "Jobs can only be pushed from job workers!");
+
+    if (counter) {
+        counter->value.fetch_add(num_jobs, std::memory_order_relaxed);
+    }
+
+    if (!system) {
+        // no workers, just run them
+        for (uint32 n = 0; n < num_jobs; n++) {
+            jobs[n].func(jobs[n].data);
+            if (counter) {
+                counter->value.fetch_sub(1, std::memory_order_release);
+            }
+        }
+        return;
+    }
+
+    job_worker* worker = &system->workers[worker_index];
+    uint32 num_pushed = 0;
+    for (uint32 n = 0; n < num_jobs; n++) {
+        // a slot stays busy until its job is taken, and there can't be more queued jobs than slots
+        job* slot = &worker->pool[worker->next_job & (JOB_QUEUE_SIZE - 1)];
+        if (!slot->busy.load(std::memory_order_acquire)) {
+            slot->func    = jobs[n].func;
+            slot->data    = jobs[n].data;
+            slot->counter = counter;
+            slot->busy.store(1, std::memory_order_relaxed);
+            if (job_deque_push(&worker->deque, slot)) {
+                worker->next_job++;
+                num_pushed++;
+                continue;
+            }
+            slot->busy.store(0, std::memory_order_relaxed);
+        }
+
+        // full
+        jobs[n].func(jobs[n].data);
+        if (counter) {
+            counter->value.fetch_sub(1, std::memory_order_release);
+        }
+        worker->num_inline.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // pairs with the sleeping worker bumping num_sleeping before its last look at the deques
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint32 num_sleeping = system->num_sleeping.load(std::memory_order_seq_cst);
+    uint32 num_to_wake = (num_pushed < num_sleeping) ? num_pushed : num_sleeping;
+    for (uint32 n = 0; n < num_to_wake; n++) {
+        platform_signal_semaphore(system->wake);
+    }
+}
+
+bool32 job_is_done(job_counter* counter) {
+    return counter->value.load(std::memory_order_acquire) == 0;
+}
+
+void job_wait(job_counter* counter) {
+    job_system* system = global_job_system;
+    uint32 worker_index = job_worker_index;
+    AssertMsg(!system || worker_index < system->num_workers, "Only job workers can wait on jobs!");
+
+    uint32 empty_rounds = 0;
+    while (counter->value.load(std::memory_order_acquire) != 0) {
+        if (system && job_try_execute(system, worker_index)) {
+            empty_rounds = 0;
+            continue;
+        }
+
+        if (++empty_rounds < JOB_WAIT_YIELD_ROUNDS) {
+            platform_cpu_pause();
+        } else {
+            platform_sleep(0);
+            empty_rounds = 0;
+        }
+    }
+}
+
+struct job_range_batch {
+    job_range_func func;
+    void* data;
+    uint64 begin;
+    uint64 end;
+};
+
+internal_func void job_range_entry(void* data) {
+    job_range_batch* batch = (job_range_batch*)data;
+    batch->func(batch->begin, batch->end, batch->data);
+}
+
+void job_parallel_for(uint64 count, uint64 min_batch, job_range_func func, void* data) {
+    if (count == 0) {
+        return;
+    }
+    if (min_batch == 0) {
+        min_batch = 1;
+    }
+
+    uint64 num_batches = (count + min_batch - 1) / min_batch;
+    uint64 max_batches = (uint64)job_system_num_workers() * JOB_BATCHES_PER_WORKER;
+    if (max_batches > JOB_MAX_BATCHES) max_batches = JOB_MAX_BATCHES;
+    if (num_batches > max_batches)     num_batches = max_batches;
+
+    if (num_batches <= 1 || !global_job_system) {
+        func(0, count, data);
+        return;
+    }
+
+    // the first num_extra batches get one more, so they all come out within 1 of each other
+    job_range_batch batches[JOB_MAX_BATCHES];
+    job_decl decls[JOB_MAX_BATCHES];
+    uint64 batch_size = count / num_batches;
+    uint64 num_extra  = count % num_batches;
+    uint64 begin = 0;
+    for (uint64 n = 0; n < num_batches; n++) {
+        uint64 end = begin + batch_size + ((n < num_extra) ? 1 : 0);
+        batches[n].func  = func;
+        batches[n].data  = data;
+        batches[n].begin = begin;
+        batches[n].end   = end;
+        decls[n].func = job_range_entry;
+        decls[n].data = &batches[n];
+        begin = end;
+    }
+
+    // this thread takes the first batch instead of waiting for someone to steal it
+    job_counter counter = {};
+    job_run(decls + 1, (uint32)(num_batches - 1), &counter);
+    job_range_entry(&batches[0]);
+    job_wait(&counter);
+}
+
+struct job_elements_range {
+    uint8* base;
+    uint64 stride;
+    job_elements_func func;
+    void* data;
+};
+
+internal_func void job_elements_entry(uint64 begin, uint64 end, void* data) {
+    job_elements_range* range = (job_elements_range*)data;
+    range->func(range->base + begin*range->stride, end - begin, range->data);
+}
+
+void job_parallel_for_array(void* dynarray, uint64 min_batch, job_elements_func func, void* data) {
+    job_elements_range range;
+    range.base   = (uint8*)dynarray;
+    range.stride = GetArrayStride(dynarray);
+    range.func   = func;
+    range.data   = data;
+    job_parallel_for(GetArrayCount(dynarray), min_batch, job_elements_entry, &range);
+}
+
+void job_parallel_for_arena(memory_arena* arena, memory_index start, memory_index end, uint64 element_size,
+                            uint64 min_batch, job_elements_func func, void* data) {
+    AssertMsg(start <= end && end <= arena->Used, "Range is outside of the arena!");
+    AssertMsg(element_size > 0 && (end - start) % element_size == 0, "Range isn't a whole number of elements!");
+
+    job_elements_range range;
+    range.base   = arena->Base + start;
+    range.stride = element_size;
+    range.func   = func;
+    range.data   = data;
+    job_parallel_for((end - start) / element_size, min_batch, job_elements_entry, &range);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Defines.h"
+
+#include <atomic>
+
+struct memory_arena;
+
+/*
+ * Job system:
+ *   One worker per physical core, with the thread that calls job_system_init() as worker 0.
+ *   Each worker has its own Chase-Lev deque: it pushes and pops jobs at the bottom without
+ *   any locks, and idle workers steal from the top of a random other worker's deque. Workers
+ *   that find nothing spin for a bit, then sleep until new jobs are pushed.
+ *
+ *   Jobs are a function and a pointer. job_run() pushes a group of them and counts them on
+ *   a job_counter, and job_wait() runs other jobs until the counter drops to 0, so waiting
+ *   inside a job (or on the main thread) never leaves a core idle. Dependencies are just
+ *   waiting on the counter of the jobs you need before running yours.
+ *
+ *   job_parallel_for() splits a range into batches across the workers and waits for them,
+ *   with helpers for dynarrays (Memory.h) and ranges of an arena.
+ *
+ *   Jobs can be pushed from any worker, including from inside a job, but not from other
+ *   threads. A job that doesn't fit in the worker's deque runs right away on the pushing thread.
+ * */
+
+#define JOB_MAX_WORKERS 64
+#define JOB_QUEUE_SIZE  4096 // jobs per worker, must be a power of 2
+
+// job_parallel_for makes at most this many batches per worker, to even out uneven batches
+#define JOB_BATCHES_PER_WORKER 4
+#define JOB_MAX_BATCHES        256
+
+typedef void (*job_func)(void* data);
+
+struct job_decl {
+    job_func func;
+    void*    data;
+};
+
+// counts unfinished jobs. zero it before the first job_run
+struct job_counter {
+    std::atomic<uint32> value;
+};
+
+struct job_system_stats {
+    uint32 num_workers;
+    uint64 num_executed; // jobs taken from a deque and run
+    uint64 num_stolen;   // of those, taken from another worker's deque
+    uint64 num_inline;   // didn't fit in a deque and ran right away
+};
+
+// num_workers of 0 is one per physical core. the calling thread becomes worker 0
+RHAPI bool32 job_system_init(uint32 num_workers);
+// runs whatever is still queued, then stops the workers
+RHAPI void   job_system_shutdown();
+RHAPI uint32 job_system_num_workers();
+RHAPI void   job_system_get_stats(job_system_stats* stats);
+
+// pushes num_jobs jobs, adding them to counter (optional). jobs and counter have to stay put until
+// the counter says they're done, but the job_decl array itself can go right after the call
+RHAPI void   job_run(const job_decl* jobs, uint32 num_jobs, job_counter* counter);
+RHAPI bool32 job_is_done(job_counter* counter);
+// runs other jobs until counter is 0
+RHAPI void   job_wait(job_counter* counter);
+
+// calls func on batches [begin, end) of [0, count), of at least min_batch each, and waits for all of them
+typedef void (*job_range_func)(uint64 begin, uint64 end, void* data);
+RHAPI void job_parallel_for(uint64 count, uint64 min_batch, job_range_func func, void* data);
+
+// same, handing func a pointer to the first element of each batch and how many there are
+typedef void (*job_elements_func)(void* elements, uint64 count, void* data);
+RHAPI void job_parallel_for_array(void* dynarray, uint64 min_batch, job_elements_func func, void* data);
+// elements of element_size bytes, from byte offset start up to end in the arena (ie. two marks of arena->Used)
+RHAPI void job_parallel_for_arena(memory_arena* arena, memory_index start, memory_index end, uint64 element_size,
+                                  uint64 min_batch, job_elements_func func, void* data);
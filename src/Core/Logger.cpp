@@ -3,19 +3,321 @@
 #include "Platform/Platform.h"
 
 #include "Core/String.h"
+#include "Core/Logger_Binary.h"
+#include "Core/Logger_File.h"
+#include "Core/Logger_Limit.h"
+#include "Memory/Memory.h"
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <atomic>
+#include <new>
 
 global_variable log_level max_log_level = log_level::LOG_LEVEL_TRACE;
 
-bool32 InitLogging(bool32 create_console, log_level max_level) {
+// everything on until InitLogging says otherwise
+uint32 global_log_channel_mask[LOG_LEVEL_TRACE + 1] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+global_variable log_level global_log_channel_levels[LOG_CHANNEL_MAX] = {
+    LOG_LEVEL_TRACE, LOG_LEVEL_TRACE, LOG_LEVEL_TRACE, LOG_LEVEL_TRACE, LOG_LEVEL_TRACE, LOG_LEVEL_TRACE
+};
+global_variable const char* global_log_channel_names[LOG_CHANNEL_MAX] = {
+    "general", "renderer", "memory", "events", "input", "platform"
+};
+
+/*
+ * Async logging:
+ *   Log calls format into a slot of a bounded lock-free MPSC ring (sequence number per slot),
+ *   and a writer thread drains it, batching consecutive messages of the same level
+ *   into a single platform_console_write.
+ *
+ *   Producers count themselves in global_log_producers while they use the queue, so
+ *   ShutdownLogging can take the queue away, wait for the ones already inside, and only
+ *   then stop the writer and free it. Anything logged after that is written synchronously.
+ * */
+#define LOG_MESSAGE_SIZE 1024
+#define LOG_BATCH_SIZE   Kilobytes(16)
+#define LOG_WRITER_WAIT_MS 10
+#define LOG_BINARY_RECORDS 4096
+
+struct log_record {
+    std::atomic<uint64> sequence;
+    log_level level;
+    uint32 length;
+    char message[LOG_MESSAGE_SIZE];
+};
+
+struct log_queue {
+    log_record* records;
+    uint64 mask;
+    log_overflow_policy overflow;
+
+    // keep producer/consumer positions on separate cache lines
+    uint8 pad0[64];
+    std::atomic<uint64> enqueue_pos;
+    uint8 pad1[64];
+    std::atomic<uint64> dequeue_pos;
+    std::atomic<uint64> written_pos; // everything before this has hit the console
+    uint8 pad2[64];
+
+    std::atomic<uint64> num_dropped;
+    std::atomic<uint32> writer_sleeping;
+    std::atomic<uint32> running;
+    void* wakeup;
+    void* writer_thread;
+
+    char batch[LOG_BATCH_SIZE];
+};
+global_variable std::atomic<log_queue*> global_log_queue;
+global_variable std::atomic<uint32> global_log_producers; // threads inside log_output that might be using the queue
+
+internal_func void log_write_to_console(const char* message, uint64 length, log_level level) {
+    log_file_write(message, length);
+
+    if (level < LOG_LEVEL_WARN) {
+        platform_console_write_error(message, (uint8)level);
+    } else {
+        platform_console_write(message, (uint8)level);
+    }
+}
+
+internal_func void log_wake_writer(log_queue* queue) {
+    if (queue->writer_sleeping.exchange(0)) {
+        platform_signal_semaphore(queue->wakeup);
+    }
+}
+
+// writes out everything currently in the queue. returns false if it was empty
+internal_func bool32 log_drain_queue(log_queue* queue) {
+    uint64 pos = queue->dequeue_pos.load(std::memory_order_relaxed);
+    uint64 batch_length = 0;
+    log_level batch_level = LOG_LEVEL_TRACE;
+    bool32 any = false;
+
+    for (;;) {
+        log_record* record = &queue->records[pos & queue->mask];
+        if (record->sequence.load(std::memory_order_acquire) != pos + 1) {
+            break; // empty (or the next producer is still writing)
+        }
+
+        // flush the batch when the level (color) changes or it won't fit
+        if (batch_length > 0 && (record->level != batch_level || batch_length + record->length + 1 > LOG_BATCH_SIZE)) {
+            queue->batch[batch_length] = 0;
+            log_write_to_console(queue->batch, batch_length, batch_level);
+            batch_length = 0;
+        }
+
+        memory_copy(queue->batch + batch_length, record->message, record->length);
+        batch_length += record->length;
+        batch_level = record->level;
+
+        // hand the slot back to producers
+        record->sequence.store(pos + queue->mask + 1, std::memory_order_release);
+        pos++;
+        queue->dequeue_pos.store(pos, std::memory_order_relaxed);
+        any = true;
+    }
+
+    if (batch_length > 0) {
+        queue->batch[batch_length] = 0;
+        log_write_to_console(queue->batch, batch_length, batch_level);
+    }
+
+    uint64 num_dropped = queue->num_dropped.exchange(0);
+    if (num_dropped) {
+        char dropped_msg[128];
+        int length = snprintf(dropped_msg, sizeof(dropped_msg), "[WARN]:  Log queue overflowed, dropped %llu messages!\n", (unsigned long long)num_dropped);
+        log_write_to_console(dropped_msg, (uint64)length, LOG_LEVEL_WARN);
+    }
+
+    queue->written_pos.store(pos, std::memory_order_release);
+    return any;
+}
+
+// every RH_LOG_DEDUP call site that has logged something
+global_variable std::atomic<log_repeat_state*> global_log_repeat_states;
+
+internal_func void log_register_repeat_state(log_repeat_state* state) {
+    log_repeat_state* head = global_log_repeat_states.load();
+    do {
+        state->next.store(head, std::memory_order_relaxed);
+    } while (!global_log_repeat_states.compare_exchange_weak(head, state));
+}
+
+internal_func uint32 log_format_message(char* buffer, uint64 buffer_size, log_channel Channel, log_level Level, const char* Message, va_list args);
+
+// straight to the console, for the writer thread, which can't wait on its own queue
+internal_func void log_write_direct(log_channel Channel, log_level Level, const char* Message, ...) {
+    char MsgBuffer[LOG_MESSAGE_SIZE];
+    va_list args;
+    va_start(args, Message);
+    uint32 length = log_format_message(MsgBuffer, sizeof(MsgBuffer), Channel, Level, Message, args);
+    va_end(args);
+    log_write_to_console(MsgBuffer, length, Level);
+}
+
+// the last repeats of a message only get reported by the next different one, so
+// report them once the call site has been quiet for a second
+internal_func void log_flush_repeat_states(bool32 force, bool32 direct) {
+    int64 now = platform_get_wall_clock();
+    for (log_repeat_state* state = global_log_repeat_states.load(); state; state = state->next.load(std::memory_order_relaxed)) {
+        if (state->repeats.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        if (!force && platform_get_seconds_elapsed(state->last_repeat.load(std::memory_order_relaxed), now) < 1.0) {
+            continue;
+        }
+
+        uint32 repeats = state->repeats.exchange(0, std::memory_order_relaxed);
+        if (repeats == 0) {
+            continue;
+        }
+        state->last_summary.store(now, std::memory_order_relaxed);
+
+        log_channel Channel = (log_channel)state->channel.load(std::memory_order_relaxed);
+        log_level Level = (log_level)state->level.load(std::memory_order_relaxed);
+        if (direct) {
+            log_write_direct(Channel, Level, "(last message repeated %u times)", repeats);
+        } else {
+            LogOutputChannel(Channel, Level, "(last message repeated %u times)", repeats);
+        }
+    }
+}
+
+internal_func uint32 log_writer_thread(void* data) {
+    log_queue* queue = (log_queue*)data;
+
+    while (queue->running.load()) {
+        // binary records don't wake us up, they get formatted whenever we're awake anyway
+        log_binary_flush();
+        log_file_flush(false);
+
+        if (log_drain_queue(queue)) {
+            continue;
+        }
+        log_flush_repeat_states(false, true);
+
+        // nothing to do, sleep until a producer wakes us up.
+        // re-check after announcing, so a message pushed in between isn't missed
+        queue->writer_sleeping.store(1);
+        if (queue->dequeue_pos.load() != queue->enqueue_pos.load()) {
+            queue->writer_sleeping.store(0);
+            continue;
+        }
+        platform_wait_semaphore(queue->wakeup, LOG_WRITER_WAIT_MS);
+        queue->writer_sleeping.store(0);
+    }
+
+    // write anything left over before shutting down
+    log_drain_queue(queue);
+    return 0;
+}
+
+void log_set_channel_level(log_channel Channel, log_level max_level) {
+    if ((uint32)Channel >= LOG_CHANNEL_MAX) {
+        return;
+    }
+    global_log_channel_levels[Channel] = max_level;
+
+    uint32 bit = 1u << Channel;
+    for (uint32 level = LOG_LEVEL_FATAL; level <= LOG_LEVEL_TRACE; level++) {
+        if (level <= (uint32)max_level) {
+            global_log_channel_mask[level] |= bit;
+        } else {
+            global_log_channel_mask[level] &= ~bit;
+        }
+    }
+}
+
+log_level log_get_channel_level(log_channel Channel) {
+    if ((uint32)Channel >= LOG_CHANNEL_MAX) {
+        return LOG_LEVEL_TRACE;
+    }
+    return global_log_channel_levels[Channel];
+}
+const char* log_get_channel_name(log_channel Channel) {
+    return (Channel < LOG_CHANNEL_MAX) ? global_log_channel_names[Channel] : "unknown";
+}
+
+bool32 InitLogging(bool32 create_console, log_level max_level, uint32 queue_depth, log_overflow_policy overflow) {
     max_log_level = max_level;
+    for (uint32 channel = 0; channel < LOG_CHANNEL_MAX; channel++) {
+        log_set_channel_level((log_channel)channel, max_level);
+    }
     platform_init_logging(create_console);
+    log_binary_init(LOG_BINARY_RECORDS);
+
+    if (queue_depth == 0) {
+        return true;
+    }
+
+    // round up to a power of 2 so slots can be found with a mask
+    uint64 num_records = 2;
+    while (num_records < queue_depth) {
+        num_records <<= 1;
+    }
+
+    void* memory = platform_alloc(sizeof(log_queue) + num_records*sizeof(log_record), 0);
+    if (!memory) {
+        return true; // still have synchronous logging
+    }
+
+    // construct the atomics in place, the memory comes back zeroed but unconstructed
+    log_queue* queue = new (memory) log_queue;
+    queue->records = (log_record*)(queue + 1);
+    queue->mask = num_records - 1;
+    queue->overflow = overflow;
+    for (uint64 n = 0; n < num_records; n++) {
+        log_record* record = new (&queue->records[n]) log_record;
+        record->sequence.store(n, std::memory_order_relaxed);
+    }
+    queue->enqueue_pos.store(0);
+    queue->dequeue_pos.store(0);
+    queue->written_pos.store(0);
+    queue->num_dropped.store(0);
+    queue->writer_sleeping.store(0);
+    queue->running.store(1);
+
+    queue->wakeup = platform_create_semaphore(0, 1);
+    queue->writer_thread = queue->wakeup ? platform_create_thread(log_writer_thread, queue) : nullptr;
+    if (!queue->writer_thread) {
+        if (queue->wakeup) {
+            platform_destroy_semaphore(queue->wakeup);
+        }
+        platform_free(queue);
+        return true;
+    }
+
+    global_log_queue.store(queue);
     return true;
 }
 
 void ShutdownLogging() {
+    log_queue* queue = global_log_queue.load();
+    if (!queue) {
+        log_flush_repeat_states(true, false);
+        log_binary_shutdown();
+        log_file_close();
+        return;
+    }
+
+    // go back to synchronous logging, and wait for anyone still writing into the queue
+    global_log_queue.store(nullptr);
+    while (global_log_producers.load() != 0) {
+        platform_sleep(0);
+    }
+
+    // then let the writer finish up
+    queue->running.store(0);
+    platform_signal_semaphore(queue->wakeup);
+    platform_join_thread(queue->writer_thread);
+
+    platform_destroy_semaphore(queue->wakeup);
+    platform_free(queue);
+
+    // writes synchronously now
+    log_flush_repeat_states(true, false);
+    log_binary_shutdown();
+    log_file_close();
 }
 
 /*
@@ -49,28 +351,179 @@ log_level log_level_from_string(char* log_level_str) {
     return log_level::LOG_LEVEL_INFO;
 }
 
-void LogOutput(log_level Level, const char* Message, ...) {
+log_channel log_channel_from_string(char* log_channel_str) {
+    for (uint32 channel = 0; channel < LOG_CHANNEL_MAX; channel++) {
+        if (string_compare(log_channel_str, global_log_channel_names[channel]) == 0) {
+            return (log_channel)channel;
+        }
+    }
+
+    return LOG_CHANNEL_GENERAL;
+}
+
+// claims a free slot in the queue, or returns nullptr if the message was dropped.
+internal_func log_record* log_claim_record(log_queue* queue, uint64* claimed_pos, bool32 never_drop) {
+    uint64 pos = queue->enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        log_record* record = &queue->records[pos & queue->mask];
+        int64 diff = (int64)record->sequence.load(std::memory_order_acquire) - (int64)pos;
+
+        if (diff == 0) {
+            if (queue->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                *claimed_pos = pos;
+                return record;
+            }
+        } else if (diff < 0) {
+            // full
+            if (queue->overflow == LOG_OVERFLOW_DROP && !never_drop) {
+                queue->num_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            log_wake_writer(queue);
+            platform_sleep(0);
+            pos = queue->enqueue_pos.load(std::memory_order_relaxed);
+        } else {
+            // another producer got here first
+            pos = queue->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+internal_func uint32 log_format_message(char* buffer, uint64 buffer_size, log_channel Channel, log_level Level, const char* Message, va_list args) {
     const char* LevelStings[6] = {"[FATAL]: ", "[ERROR]: ", "[WARN]:  ", "[INFO]:  ", "[DEBUG]: ", "[TRACE]: "};
-    if (Level <= max_log_level) {
-        bool32 IsError = Level < LOG_LEVEL_WARN;
 
-        char MsgBuffer[1024] = { 0 };
+    int offset;
+    if (Channel == LOG_CHANNEL_GENERAL) {
+        offset = snprintf(buffer, buffer_size, "%s", LevelStings[Level]);
+    } else {
+        offset = snprintf(buffer, buffer_size, "%s[%s] ", LevelStings[Level], global_log_channel_names[Channel]);
+    }
+    int written = vsnprintf(buffer + offset, buffer_size - offset, Message, args);
+    if (written > 0) {
+        offset += written;
+    }
+
+    // leave room for the newline if the message was truncated
+    if (offset > (int)buffer_size - 2) {
+        offset = (int)buffer_size - 2;
+    }
+    buffer[offset] = '\n';
+    buffer[offset + 1] = '\0';
 
-        int offset = snprintf(MsgBuffer, sizeof(MsgBuffer), "%s", LevelStings[Level]);
+    return (uint32)(offset + 1);
+}
 
+internal_func void log_output(log_channel Channel, log_level Level, const char* Message, va_list args) {
+    // count ourselves in before looking at the queue, so ShutdownLogging can't free it under us
+    global_log_producers.fetch_add(1);
+    log_queue* queue = global_log_queue.load();
+    if (queue) {
+        uint64 pos;
+        log_record* record = log_claim_record(queue, &pos, Level == LOG_LEVEL_FATAL);
+        if (record) {
+            record->level  = Level;
+            record->length = log_format_message(record->message, sizeof(record->message), Channel, Level, Message, args);
+            record->sequence.store(pos + 1, std::memory_order_release);
+
+            log_wake_writer(queue);
+
+            if (Level == LOG_LEVEL_FATAL) {
+                // don't return until this (and everything before it) is on screen
+                while (queue->written_pos.load(std::memory_order_acquire) <= pos) {
+                    log_wake_writer(queue);
+                    platform_sleep(0);
+                }
+            }
+        }
+        global_log_producers.fetch_sub(1, std::memory_order_release);
+    } else {
+        global_log_producers.fetch_sub(1, std::memory_order_release);
+
+        char MsgBuffer[LOG_MESSAGE_SIZE];
+        uint32 length = log_format_message(MsgBuffer, sizeof(MsgBuffer), Channel, Level, Message, args);
+        log_write_to_console(MsgBuffer, length, Level);
+    }
+
+    if (Level == LOG_LEVEL_FATAL) {
+        // probably about to go down, get it to disk
+        log_file_flush(true);
+    }
+}
+
+void LogOutput(log_level Level, const char* Message, ...) {
+    if (Level <= max_log_level) {
         va_list args;
         va_start(args, Message);
-        offset += vsnprintf(MsgBuffer + offset, sizeof(MsgBuffer)-offset, Message, args);
+        log_output(LOG_CHANNEL_GENERAL, Level, Message, args);
         va_end(args);
-        MsgBuffer[offset] = '\n';
-        MsgBuffer[offset + 1] = '\0';
+    }
+}
 
-        if (IsError) {
-            platform_console_write_error(MsgBuffer, (uint8)Level);
-        } else {
-            platform_console_write(MsgBuffer, (uint8)Level);
+// the RH_ macros have already checked the channel mask
+void LogOutputChannel(log_channel Channel, log_level Level, const char* Message, ...) {
+    if ((uint32)Channel >= LOG_CHANNEL_MAX) {
+        Channel = LOG_CHANNEL_GENERAL;
+    }
+
+    va_list args;
+    va_start(args, Message);
+    log_output(Channel, Level, Message, args);
+    va_end(args);
+}
+
+bool32 log_rate_limit_check(log_rate_limit* limit, uint32 max_per_second, uint32* num_suppressed) {
+    *num_suppressed = 0;
+
+    int64 now = platform_get_wall_clock();
+    int64 start = limit->window_start.load(std::memory_order_relaxed);
+    if (start == 0 || platform_get_seconds_elapsed(start, now) >= 1.0) {
+        // whoever starts the new window gets through, and reports the old one
+        if (limit->window_start.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+            limit->count.store(1, std::memory_order_relaxed);
+            *num_suppressed = limit->suppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    if (limit->count.fetch_add(1, std::memory_order_relaxed) < max_per_second) {
+        return true;
+    }
+    limit->suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool32 log_repeat_check(log_repeat_state* state, uint64 key, log_channel Channel, log_level Level) {
+    if (!state->registered.load(std::memory_order_relaxed) && !state->registered.exchange(1)) {
+        log_register_repeat_state(state);
+    }
+
+    int64 now = platform_get_wall_clock();
+    if (state->key.load(std::memory_order_relaxed) == key) {
+        uint32 repeats = state->repeats.fetch_add(1, std::memory_order_relaxed) + 1;
+        state->last_repeat.store(now, std::memory_order_relaxed);
+
+        int64 last_summary = state->last_summary.load(std::memory_order_relaxed);
+        if (platform_get_seconds_elapsed(last_summary, now) >= 1.0 &&
+            state->last_summary.compare_exchange_strong(last_summary, now, std::memory_order_relaxed)) {
+            state->repeats.fetch_sub(repeats, std::memory_order_relaxed);
+            LogOutputChannel(Channel, Level, "(last message repeated %u times)", repeats);
         }
+        return false;
+    }
+
+    state->key.store(key, std::memory_order_relaxed);
+    state->channel.store((uint32)Channel, std::memory_order_relaxed);
+    state->level.store((uint32)Level, std::memory_order_relaxed);
+    state->last_summary.store(now, std::memory_order_relaxed);
+    uint32 repeats = state->repeats.exchange(0, std::memory_order_relaxed);
+    if (repeats > 0) {
+        LogOutputChannel(Channel, Level, "(last message repeated %u times)", repeats);
     }
+    return true;
+}
+
+void log_flush_repeats(bool32 force) {
+    log_flush_repeat_states(force, false);
 }
 
 bool32 ReportAssertionFailure(const char* expression, const char* message, const char* file, int32 line) {
@@ -2,59 +2,116 @@
 
 #include "Defines.h"
 
-#define LOG_WARN_ENABLED 1
-#define LOG_INFO_ENABLED 1
-#define LOG_DEBUG_ENABLED 1
-#define LOG_TRACE_ENABLED 1
-
+/*
+ * Compile-time floor:
+ *   Anything above RH_LOG_COMPILE_LEVEL is stripped out entirely.
+ *   (numeric, so the preprocessor can compare it: 2 = WARN, 3 = INFO, 4 = DEBUG, 5 = TRACE)
+ *   Define it before including this file (or on the command line) to override.
+ * */
+#ifndef RH_LOG_COMPILE_LEVEL
 // Disable debug and trace logging for release builds.
 #if RH_RELEASE == 1
-#define LOG_DEBUG_ENABLED 0
-#define LOG_TRACE_ENABLED 0
+#define RH_LOG_COMPILE_LEVEL 3
+#else
+#define RH_LOG_COMPILE_LEVEL 5
 #endif
+#endif
+
+#define LOG_WARN_ENABLED  (RH_LOG_COMPILE_LEVEL >= 2)
+#define LOG_INFO_ENABLED  (RH_LOG_COMPILE_LEVEL >= 3)
+#define LOG_DEBUG_ENABLED (RH_LOG_COMPILE_LEVEL >= 4)
+#define LOG_TRACE_ENABLED (RH_LOG_COMPILE_LEVEL >= 5)
+
+/*
+ * Channels:
+ *   Each subsystem logs to its own channel, which has its own runtime level.
+ *   The levels are cached as one bitmask per log_level (a bit per channel), so
+ *   the macros test a single bit before any of their arguments are evaluated.
+ * */
+enum log_channel {
+    LOG_CHANNEL_GENERAL  = 0,
+    LOG_CHANNEL_RENDERER = 1,
+    LOG_CHANNEL_MEMORY   = 2,
+    LOG_CHANNEL_EVENTS   = 3,
+    LOG_CHANNEL_INPUT    = 4,
+    LOG_CHANNEL_PLATFORM = 5,
+
+    LOG_CHANNEL_MAX
+};
+
+// bit n of global_log_channel_mask[level] is set if channel n logs at that level.
+// only written by log_set_channel_level
+RHAPI extern uint32 global_log_channel_mask[LOG_LEVEL_TRACE + 1];
 
-RHAPI bool32 InitLogging(bool32 create_console, log_level max_log_level = LOG_LEVEL_INFO);
+#define LOG_CHANNEL_ENABLED(Channel, Level) (global_log_channel_mask[Level] & (1u << (Channel)))
+
+// what a log call does when the async queue is full
+enum log_overflow_policy {
+    LOG_OVERFLOW_BLOCK = 0, // wait for the writer thread to catch up
+    LOG_OVERFLOW_DROP  = 1, // throw the message away (counted, and reported later)
+};
+
+// queue_depth > 0 writes to the console from a background thread, 0 writes synchronously.
+// FATAL messages always wait until everything before them (and themselves) is written.
+RHAPI bool32 InitLogging(bool32 create_console, log_level max_log_level = LOG_LEVEL_INFO,
+                         uint32 queue_depth = 1024, log_overflow_policy overflow = LOG_OVERFLOW_BLOCK);
 RHAPI void ShutdownLogging();
 RHAPI log_level log_level_from_string(char* log_level_str);
+RHAPI log_channel log_channel_from_string(char* log_channel_str);
+
+// InitLogging sets every channel to max_log_level, this overrides one of them.
+RHAPI void log_set_channel_level(log_channel Channel, log_level max_level);
+RHAPI log_level log_get_channel_level(log_channel Channel);
+RHAPI const char* log_get_channel_name(log_channel Channel);
 
 RHAPI void LogOutput(log_level Level, const char* Message, ...);
+RHAPI void LogOutputChannel(log_channel Channel, log_level Level, const char* Message, ...);
+
+// Checks the channel mask before evaluating any arguments.
+#define RH_LOG(Channel, Level, Message, ...) { if (LOG_CHANNEL_ENABLED(Channel, Level)) { LogOutputChannel(Channel, Level, Message, ##__VA_ARGS__); } }
 
 // Logs a fatal-level message.
-#define RH_FATAL(Message, ...) LogOutput(LOG_LEVEL_FATAL, Message, ##__VA_ARGS__);
+#define RH_FATAL_CH(Channel, Message, ...) RH_LOG(Channel, LOG_LEVEL_FATAL, Message, ##__VA_ARGS__);
+#define RH_FATAL(Message, ...) RH_FATAL_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
 
-#ifndef RH_ERROR
 // Logs an error-level message.
-#define RH_ERROR(Message, ...) LogOutput(LOG_LEVEL_ERROR, Message, ##__VA_ARGS__);
+#define RH_ERROR_CH(Channel, Message, ...) RH_LOG(Channel, LOG_LEVEL_ERROR, Message, ##__VA_ARGS__);
+#ifndef RH_ERROR
+#define RH_ERROR(Message, ...) RH_ERROR_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
 #endif
 
 #if LOG_WARN_ENABLED == 1
 // Logs a warning-level message.
-#define RH_WARN(Message, ...) LogOutput(LOG_LEVEL_WARN, Message, ##__VA_ARGS__);
+#define RH_WARN_CH(Channel, Message, ...) RH_LOG(Channel, LOG_LEVEL_WARN, Message, ##__VA_ARGS__);
 #else
 // Does nothing when LOG_WARN_ENABLED != 1
-#define RH_WARN(Message, ...)
+#define RH_WARN_CH(Channel, Message, ...)
 #endif
+#define RH_WARN(Message, ...) RH_WARN_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
 
 #if LOG_INFO_ENABLED == 1
 // Logs a info-level message.
-#define RH_INFO(Message, ...) LogOutput(LOG_LEVEL_INFO, Message, ##__VA_ARGS__);
+#define RH_INFO_CH(Channel, Message, ...) RH_LOG(Channel, LOG_LEVEL_INFO, Message, ##__VA_ARGS__);
 #else
 // Does nothing when LOG_INFO_ENABLED != 1
-#define RH_INFO(Message, ...)
+#define RH_INFO_CH(Channel, Message, ...)
 #endif
+#define RH_INFO(Message, ...) RH_INFO_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
 
 #if LOG_DEBUG_ENABLED == 1
 // Logs a debug-level message.
-#define RH_DEBUG(Message, ...) LogOutput(LOG_LEVEL_DEBUG, Message, ##__VA_ARGS__);
+#define RH_DEBUG_CH(Channel, Message, ...) RH_LOG(Channel, LOG_LEVEL_DEBUG, Message, ##__VA_ARGS__);
 #else
 // Does nothing when LOG_DEBUG_ENABLED != 1
-#define RH_DEBUG(Message, ...)
+#define RH_DEBUG_CH(Channel, Message, ...)
 #endif
+#define RH_DEBUG(Message, ...) RH_DEBUG_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
 
 #if LOG_TRACE_ENABLED == 1
 // Logs a trace-level message.
-#define RH_TRACE(Message, ...) LogOutput(LOG_LEVEL_TRACE, Message, ##__VA_ARGS__);
+#define RH_TRACE_CH(Channel, Message, ...) RH_LOG(Channel, LOG_LEVEL_TRACE, Message, ##__VA_ARGS__);
 #else
 // Does nothing when LOG_TRACE_ENABLED != 1
-#define RH_TRACE(Message, ...)
-#endif
\ No newline at end of file
+#define RH_TRACE_CH(Channel, Message, ...)
+#endif
+#define RH_TRACE(Message, ...) RH_TRACE_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
@@ -0,0 +1,226 @@
+#include "Logger_Binary.h"
+#include "Logger_File.h"
+
+#include "Platform/Platform.h"
+#include "Memory/Memory.h"
+
+#include <atomic>
+#include <new>
+
+#define LOG_BINARY_MESSAGE_SIZE 1024
+#define LOG_BINARY_BATCH_SIZE   Kilobytes(16)
+
+struct log_binary_record {
+    // pos+1 once written, 0 while a producer is writing it
+    std::atomic<uint64> sequence;
+
+    const char* fmt;
+    log_binary_format_func formatter;
+    int64 timestamp;
+    log_channel channel;
+    log_level level;
+    uint32 args_size;
+    uint8 args[LOG_BINARY_ARGS_SIZE];
+};
+
+struct log_binary_ring {
+    log_binary_record* records;
+    uint64 mask;
+    int64 start_clock;
+
+    uint8 pad0[64];
+    std::atomic<uint64> write_pos;
+    uint8 pad1[64];
+    uint64 read_pos;
+    uint64 num_lost;
+    std::atomic<uint32> flushing; // only one consumer at a time
+
+    char batch[LOG_BINARY_BATCH_SIZE];
+};
+global_variable std::atomic<log_binary_ring*> global_binary_ring;
+global_variable std::atomic<uint32> global_binary_users; // threads writing or flushing that might be using the ring
+
+// counts us in before looking at the ring, so log_binary_shutdown can't free it under us.
+// call log_binary_release() when done, even if this returns null
+internal_func log_binary_ring* log_binary_acquire() {
+    global_binary_users.fetch_add(1);
+    return global_binary_ring.load();
+}
+internal_func void log_binary_release() {
+    global_binary_users.fetch_sub(1, std::memory_order_release);
+}
+
+bool32 log_binary_init(uint32 num_records) {
+    // round up to a power of 2 so slots can be found with a mask
+    uint64 capacity = 2;
+    while (capacity < num_records) {
+        capacity <<= 1;
+    }
+
+    void* memory = platform_alloc(sizeof(log_binary_ring) + capacity*sizeof(log_binary_record), 0);
+    if (!memory) {
+        return false;
+    }
+
+    // construct the atomics in place, the memory comes back zeroed but unconstructed
+    log_binary_ring* ring = new (memory) log_binary_ring;
+    ring->records = (log_binary_record*)(ring + 1);
+    ring->mask = capacity - 1;
+    ring->start_clock = platform_get_wall_clock();
+    for (uint64 n = 0; n < capacity; n++) {
+        log_binary_record* record = new (&ring->records[n]) log_binary_record;
+        record->sequence.store(0, std::memory_order_relaxed);
+    }
+    ring->write_pos.store(0);
+    ring->read_pos = 0;
+    ring->num_lost = 0;
+    ring->flushing.store(0);
+
+    global_binary_ring.store(ring);
+    return true;
+}
+
+internal_func void log_binary_flush_ring(log_binary_ring* ring);
+
+void log_binary_shutdown() {
+    // take the ring away, and wait for anyone still writing into it or flushing it
+    log_binary_ring* ring = global_binary_ring.exchange(nullptr);
+    if (!ring) {
+        return;
+    }
+    while (global_binary_users.load() != 0) {
+        platform_sleep(0);
+    }
+
+    log_binary_flush_ring(ring);
+    platform_free(ring);
+}
+
+void log_binary_write(log_channel channel, log_level level, const char* fmt, log_binary_format_func formatter, const uint8* args, uint32 args_size) {
+    log_binary_ring* ring = log_binary_acquire();
+    if (!ring) {
+        log_binary_release();
+        return;
+    }
+
+    uint64 pos = ring->write_pos.fetch_add(1, std::memory_order_relaxed);
+    log_binary_record* record = &ring->records[pos & ring->mask];
+
+    // mark busy, so a consumer doesn't read a half-written record
+    record->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record->fmt       = fmt;
+    record->formatter = formatter;
+    record->timestamp = platform_get_wall_clock();
+    record->channel   = channel;
+    record->level     = level;
+    record->args_size = args_size;
+    memory_copy(record->args, args, args_size);
+
+    record->sequence.store(pos + 1, std::memory_order_release);
+    log_binary_release();
+}
+
+internal_func void log_binary_write_batch(log_binary_ring* ring, uint64 length, log_level level) {
+    ring->batch[length] = 0;
+    log_file_write(ring->batch, length);
+    if (level < LOG_LEVEL_WARN) {
+        platform_console_write_error(ring->batch, (uint8)level);
+    } else {
+        platform_console_write(ring->batch, (uint8)level);
+    }
+}
+
+void log_binary_flush() {
+    log_binary_ring* ring = log_binary_acquire();
+    if (ring) {
+        log_binary_flush_ring(ring);
+    }
+    log_binary_release();
+}
+
+internal_func void log_binary_flush_ring(log_binary_ring* ring) {
+    const char* LevelStings[6] = {"[FATAL]: ", "[ERROR]: ", "[WARN]:  ", "[INFO]:  ", "[DEBUG]: ", "[TRACE]: "};
+
+    if (ring->flushing.exchange(1)) {
+        return; // someone else is already flushing
+    }
+
+    uint64 write_pos = ring->write_pos.load(std::memory_order_acquire);
+    uint64 capacity = ring->mask + 1;
+    if (write_pos - ring->read_pos > capacity) {
+        // producers lapped us, the oldest records are gone
+        ring->num_lost += (write_pos - ring->read_pos) - capacity;
+        ring->read_pos = write_pos - capacity;
+    }
+
+    uint64 batch_length = 0;
+    log_level batch_level = LOG_LEVEL_TRACE;
+    while (ring->read_pos < write_pos) {
+        uint64 pos = ring->read_pos;
+        log_binary_record* record = &ring->records[pos & ring->mask];
+
+        uint64 sequence = record->sequence.load(std::memory_order_acquire);
+        if (sequence < pos + 1) {
+            break; // still being written, pick it up next time
+        }
+
+        // copy it out, then make sure it wasn't overwritten while copying
+        log_binary_record copy;
+        copy.fmt       = record->fmt;
+        copy.formatter = record->formatter;
+        copy.timestamp = record->timestamp;
+        copy.channel   = record->channel;
+        copy.level     = record->level;
+        copy.args_size = record->args_size;
+        memory_copy(copy.args, record->args, copy.args_size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        ring->read_pos++;
+        if (sequence != pos + 1 || record->sequence.load(std::memory_order_relaxed) != sequence) {
+            ring->num_lost++;
+            continue;
+        }
+
+        char message[LOG_BINARY_MESSAGE_SIZE];
+        real64 ms = 1000.0 * platform_get_seconds_elapsed(ring->start_clock, copy.timestamp);
+        int offset;
+        if (copy.channel == LOG_CHANNEL_GENERAL) {
+            offset = snprintf(message, sizeof(message), "%s[%10.3f ms] ", LevelStings[copy.level], ms);
+        } else {
+            offset = snprintf(message, sizeof(message), "%s[%s] [%10.3f ms] ", LevelStings[copy.level], log_get_channel_name(copy.channel), ms);
+        }
+        int written = copy.formatter(message + offset, sizeof(message) - offset, copy.fmt, copy.args);
+        if (written > 0) {
+            offset += written;
+        }
+        if (offset > (int)sizeof(message) - 2) {
+            offset = (int)sizeof(message) - 2;
+        }
+        message[offset++] = '\n';
+
+        // batch consecutive records of the same level into one write
+        if (batch_length > 0 && (copy.level != batch_level || batch_length + offset + 1 > LOG_BINARY_BATCH_SIZE)) {
+            log_binary_write_batch(ring, batch_length, batch_level);
+            batch_length = 0;
+        }
+        memory_copy(ring->batch + batch_length, message, offset);
+        batch_length += offset;
+        batch_level = copy.level;
+    }
+
+    if (batch_length > 0) {
+        log_binary_write_batch(ring, batch_length, batch_level);
+    }
+
+    if (ring->num_lost) {
+        char lost_msg[128];
+        int length = snprintf(lost_msg, sizeof(lost_msg), "[WARN]:  Binary log ring overflowed, lost %llu records!\n", (unsigned long long)ring->num_lost);
+        log_file_write(lost_msg, (uint64)length);
+        platform_console_write(lost_msg, (uint8)LOG_LEVEL_WARN);
+        ring->num_lost = 0;
+    }
+
+    ring->flushing.store(0);
+}
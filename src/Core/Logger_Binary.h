@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/Logger.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Binary (deferred-format) logging:
+ *   RH_TRACE_BIN and friends don't format anything on the calling thread. They store
+ *   the format string pointer, a timestamp, and the raw argument bytes into a ring buffer.
+ *   The argument layout is worked out at compile time from the argument types, and the
+ *   matching formatter is a template instantiation, so nothing about the types needs
+ *   to be stored.
+ *
+ *   Records get formatted when they are consumed: by the logger's writer thread, by
+ *   log_binary_flush(), or at ShutdownLogging(). The ring keeps the most recent records;
+ *   if it laps the consumer, the overwritten ones are reported as lost.
+ *   log_binary_shutdown() waits for anyone still writing a record before freeing the
+ *   ring; records logged after that are dropped.
+ *
+ *   The macros check the channel's mask first, same as RH_TRACE_CH and friends, so a
+ *   filtered-out call is one load and a bit test.
+ *   The format string must be a literal (or otherwise outlive the record).
+ *   Strings (char*) are copied into the record, truncated to fit.
+ * */
+
+#define LOG_BINARY_ARGS_SIZE 96
+
+typedef int (*log_binary_format_func)(char* buffer, uint64 buffer_size, const char* fmt, const uint8* args);
+
+bool32 log_binary_init(uint32 num_records);
+void log_binary_shutdown();
+
+RHAPI void log_binary_write(log_channel channel, log_level level, const char* fmt, log_binary_format_func formatter, const uint8* args, uint32 args_size);
+// formats and writes out every record that hasn't been yet
+RHAPI void log_binary_flush();
+
+// encode/decode a single argument
+template <typename T>
+struct log_binary_arg {
+    static const uint32 min_size = sizeof(T);
+
+    static inline uint8* encode(uint8* dst, uint8* end, T value) {
+        memcpy(dst, &value, sizeof(T));
+        return dst + sizeof(T);
+    }
+    static inline T decode(const uint8** src) {
+        T value;
+        memcpy(&value, *src, sizeof(T));
+        *src += sizeof(T);
+        return value;
+    }
+};
+
+// strings are copied in as [length][chars][0], since the pointer is
+// probably not valid anymore by the time the record is formatted.
+template <>
+struct log_binary_arg<const char*> {
+    static const uint32 min_size = 2;
+
+    static inline uint8* encode(uint8* dst, uint8* end, const char* value) {
+        uint8* length = dst++;
+        uint8* max = end - 1; // room for the null-terminator
+        if (max - dst > 255) {
+            max = dst + 255;
+        }
+        while (value && *value && dst < max) {
+            *dst++ = (uint8)*value++;
+        }
+        *length = (uint8)(dst - length - 1);
+        *dst++ = 0;
+        return dst;
+    }
+    static inline const char* decode(const uint8** src) {
+        const char* value = (const char*)(*src + 1);
+        *src += **src + 2;
+        return value;
+    }
+};
+template <>
+struct log_binary_arg<char*> : log_binary_arg<const char*> {
+};
+
+// encode/decode a whole argument list
+template <typename... Args>
+struct log_binary_args;
+
+template <>
+struct log_binary_args<> {
+    static const uint32 min_size = 0;
+
+    static inline uint8* encode(uint8* dst, uint8* end) {
+        return dst;
+    }
+
+    template <typename... Decoded>
+    static int format(char* buffer, uint64 buffer_size, const char* fmt, const uint8* src, Decoded... decoded) {
+        return snprintf(buffer, (size_t)buffer_size, fmt, decoded...);
+    }
+};
+
+template <typename First, typename... Rest>
+struct log_binary_args<First, Rest...> {
+    static const uint32 min_size = log_binary_arg<First>::min_size + log_binary_args<Rest...>::min_size;
+
+    static inline uint8* encode(uint8* dst, uint8* end, First first, Rest... rest) {
+        // a string can only use what's left after the fixed-size args behind it
+        dst = log_binary_arg<First>::encode(dst, end - log_binary_args<Rest...>::min_size, first);
+        return log_binary_args<Rest...>::encode(dst, end, rest...);
+    }
+
+    template <typename... Decoded>
+    static int format(char* buffer, uint64 buffer_size, const char* fmt, const uint8* src, Decoded... decoded) {
+        auto value = log_binary_arg<First>::decode(&src);
+        return log_binary_args<Rest...>::format(buffer, buffer_size, fmt, src, decoded..., value);
+    }
+};
+
+template <typename... Args>
+inline void log_binary(log_channel channel, log_level level, const char* fmt, Args... args) {
+    static_assert(log_binary_args<Args...>::min_size <= LOG_BINARY_ARGS_SIZE, "Too many arguments for a binary log record!");
+
+    uint8 bytes[LOG_BINARY_ARGS_SIZE];
+    uint8* end = log_binary_args<Args...>::encode(bytes, bytes + LOG_BINARY_ARGS_SIZE, args...);
+    log_binary_write(channel, level, fmt, &log_binary_args<Args...>::template format<>, bytes, (uint32)(end - bytes));
+}
+
+#define RH_LOG_BIN(Channel, Level, Message, ...) { if (LOG_CHANNEL_ENABLED(Channel, Level)) { log_binary(Channel, Level, Message, ##__VA_ARGS__); } }
+
+#if LOG_INFO_ENABLED == 1
+// Logs a info-level message, formatted later.
+#define RH_INFO_BIN_CH(Channel, Message, ...) RH_LOG_BIN(Channel, LOG_LEVEL_INFO, Message, ##__VA_ARGS__);
+#else
+// Does nothing when LOG_INFO_ENABLED != 1
+#define RH_INFO_BIN_CH(Channel, Message, ...)
+#endif
+#define RH_INFO_BIN(Message, ...) RH_INFO_BIN_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
+
+#if LOG_DEBUG_ENABLED == 1
+// Logs a debug-level message, formatted later.
+#define RH_DEBUG_BIN_CH(Channel, Message, ...) RH_LOG_BIN(Channel, LOG_LEVEL_DEBUG, Message, ##__VA_ARGS__);
+#else
+// Does nothing when LOG_DEBUG_ENABLED != 1
+#define RH_DEBUG_BIN_CH(Channel, Message, ...)
+#endif
+#define RH_DEBUG_BIN(Message, ...) RH_DEBUG_BIN_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
+
+#if LOG_TRACE_ENABLED == 1
+// Logs a trace-level message, formatted later.
+#define RH_TRACE_BIN_CH(Channel, Message, ...) RH_LOG_BIN(Channel, LOG_LEVEL_TRACE, Message, ##__VA_ARGS__);
+#else
+// Does nothing when LOG_TRACE_ENABLED != 1
+#define RH_TRACE_BIN_CH(Channel, Message, ...)
+#endif
+#define RH_TRACE_BIN(Message, ...) RH_TRACE_BIN_CH(LOG_CHANNEL_GENERAL, Message, ##__VA_ARGS__)
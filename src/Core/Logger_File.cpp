@@ -0,0 +1,142 @@
+#include "Logger_File.h"
+
+#include "Platform/Platform.h"
+#include "Memory/Memory.h"
+
+#include <stdio.h>
+#include <atomic>
+
+#define LOG_FILE_MIN_SIZE Kilobytes(64)
+#define LOG_FILE_FLUSH_MS 250
+#define LOG_FILE_MAX_PATH 512
+
+struct log_file_sink {
+    mapped_file file;
+    uint64 used;
+    uint64 flushed;
+    uint64 max_file_size;
+    uint32 max_files;
+    int64 last_flush;
+    char path[LOG_FILE_MAX_PATH];
+
+    std::atomic<uint32> active;
+    std::atomic<uint32> lock; // writes are just a memcpy, so spin
+};
+global_variable log_file_sink global_log_file;
+
+internal_func void log_file_lock(log_file_sink* sink) {
+    while (sink->lock.exchange(1, std::memory_order_acquire)) {
+        platform_sleep(0);
+    }
+}
+internal_func void log_file_unlock(log_file_sink* sink) {
+    sink->lock.store(0, std::memory_order_release);
+}
+
+// closes the current file, shifts the old ones up by one, and starts a fresh one
+internal_func bool32 log_file_rotate(log_file_sink* sink) {
+    platform_close_mapped_file(&sink->file, sink->used);
+    sink->used = 0;
+    sink->flushed = 0;
+
+    char src[LOG_FILE_MAX_PATH + 16];
+    char dst[LOG_FILE_MAX_PATH + 16];
+    for (uint32 n = sink->max_files - 1; n > 0; n--) {
+        if (n == 1) {
+            snprintf(src, sizeof(src), "%s", sink->path);
+        } else {
+            snprintf(src, sizeof(src), "%s.%u", sink->path, n - 1);
+        }
+        snprintf(dst, sizeof(dst), "%s.%u", sink->path, n);
+
+        // missing files are fine, the chain just isn't full yet
+        platform_move_file(src, dst);
+    }
+
+    return platform_create_mapped_file(sink->path, sink->max_file_size, &sink->file);
+}
+
+bool32 log_file_open(const char* full_path, uint64 max_file_size, uint32 max_files) {
+    log_file_close();
+
+    log_file_sink* sink = &global_log_file;
+    log_file_lock(sink);
+
+    int path_length = snprintf(sink->path, sizeof(sink->path), "%s", full_path);
+    if (path_length <= 0 || path_length >= (int)sizeof(sink->path)) {
+        log_file_unlock(sink);
+        return false;
+    }
+
+    sink->max_file_size = max_file_size < LOG_FILE_MIN_SIZE ? LOG_FILE_MIN_SIZE : max_file_size;
+    sink->max_files = max_files > 0 ? max_files : 1;
+    sink->used = 0;
+    sink->flushed = 0;
+    sink->last_flush = platform_get_wall_clock();
+
+    bool32 result = log_file_rotate(sink);
+    sink->active.store(result ? 1 : 0);
+
+    log_file_unlock(sink);
+    return result;
+}
+
+void log_file_close() {
+    log_file_sink* sink = &global_log_file;
+    log_file_lock(sink);
+
+    sink->active.store(0);
+    platform_close_mapped_file(&sink->file, sink->used);
+    sink->used = 0;
+    sink->flushed = 0;
+
+    log_file_unlock(sink);
+}
+
+void log_file_write(const char* message, uint64 length) {
+    log_file_sink* sink = &global_log_file;
+    if (!sink->active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    log_file_lock(sink);
+    if (sink->file.data) {
+        if (length > sink->file.num_bytes) {
+            length = sink->file.num_bytes;
+        }
+
+        if (sink->used + length > sink->file.num_bytes) {
+            if (!log_file_rotate(sink)) {
+                // nowhere left to write, give up on the file
+                sink->active.store(0);
+                log_file_unlock(sink);
+                return;
+            }
+        }
+
+        memory_copy(sink->file.data + sink->used, message, length);
+        sink->used += length;
+    }
+    log_file_unlock(sink);
+}
+
+void log_file_flush(bool32 force) {
+    log_file_sink* sink = &global_log_file;
+    if (!sink->active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    int64 now = platform_get_wall_clock();
+
+    log_file_lock(sink);
+    if (!force && platform_get_seconds_elapsed(sink->last_flush, now) < (LOG_FILE_FLUSH_MS / 1000.0)) {
+        log_file_unlock(sink);
+        return;
+    }
+    if (sink->file.data && sink->used > sink->flushed) {
+        platform_flush_mapped_file(&sink->file, sink->flushed, sink->used - sink->flushed);
+        sink->flushed = sink->used;
+    }
+    sink->last_flush = now;
+    log_file_unlock(sink);
+}
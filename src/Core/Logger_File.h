@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * Log file sink:
+ *   Everything written to the console also gets appended to a memory-mapped log file.
+ *   The file is created at its full size up front, so appending a line is just a memcpy
+ *   into the mapping (no syscall). Once a process crashes the mapped pages still belong
+ *   to the OS, so everything copied in before the crash makes it to disk.
+ *
+ *   The logger's writer thread flushes the mapping every LOG_FILE_FLUSH_MS without waiting
+ *   on the disk, and FATAL messages flush right away.
+ *
+ *   When the file is full it is closed (truncated to what was written) and rotated:
+ *   full_path -> full_path.1 -> full_path.2 ... up to max_files. Opening rotates too, so
+ *   the previous run's log is kept. A log that wasn't closed cleanly ends in zeroes.
+ * */
+
+RHAPI bool32 log_file_open(const char* full_path, uint64 max_file_size = Megabytes(8), uint32 max_files = 4);
+RHAPI void log_file_close();
+
+void log_file_write(const char* message, uint64 length);
+// flushes the mapping if it's been LOG_FILE_FLUSH_MS since the last one (or force is set)
+void log_file_flush(bool32 force);
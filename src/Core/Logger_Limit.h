@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/Logger.h"
+
+#include <atomic>
+
+/*
+ * Rate-limited / deduplicated logging:
+ *   For log statements that can fire every frame. Each call site gets its own
+ *   static state, so the check is a couple of atomics after the channel mask test.
+ *
+ *   RH_LOG_RATE(Channel, Level, PerSecond, ...) lets at most PerSecond messages through
+ *   per second, and reports how many were suppressed when the next one gets through.
+ *
+ *   RH_LOG_DEDUP(Channel, Level, ...) collapses identical consecutive messages from a
+ *   call site into "(last message repeated N times)". Messages are compared by a key made
+ *   from the format pointer and the raw argument values (strings by their contents), so a
+ *   repeat is caught before anything is formatted. The summary is written when the message
+ *   changes, at most once a second while it keeps repeating, about a second after it stops
+ *   (by the log writer thread), and at ShutdownLogging.
+ *   Call sites stay on a list once they've logged, so don't use it from code that gets unloaded.
+ *
+ *   Both only go through the runtime channel mask, not the RH_LOG_COMPILE_LEVEL floor.
+ * */
+
+struct log_rate_limit {
+    std::atomic<int64>  window_start;
+    std::atomic<uint32> count;
+    std::atomic<uint32> suppressed;
+};
+
+struct log_repeat_state {
+    std::atomic<uint64> key; // 0 until something is logged
+    std::atomic<uint32> repeats;
+    std::atomic<int64>  last_summary;
+    std::atomic<int64>  last_repeat;
+    std::atomic<uint32> channel;
+    std::atomic<uint32> level;
+
+    // every call site that has logged, so pending repeats can be flushed
+    std::atomic<uint32> registered;
+    std::atomic<log_repeat_state*> next;
+};
+
+// dedup keys: FNV-1a over the raw bytes of the format pointer and each argument
+#define LOG_DEDUP_SEED 0xcbf29ce484222325ull
+
+inline uint64 log_dedup_mix(uint64 key, const void* data, uint64 size) {
+    const uint8* bytes = (const uint8*)data;
+    for (uint64 n = 0; n < size; n++) {
+        key = (key ^ bytes[n]) * 0x100000001b3ull;
+    }
+    return key;
+}
+
+template <typename T>
+inline uint64 log_dedup_key_arg(uint64 key, const T& arg) {
+    return log_dedup_mix(key, &arg, sizeof(T));
+}
+// strings go in by contents, the same buffer can hold a different message next time
+inline uint64 log_dedup_key_arg(uint64 key, const char* str) {
+    if (!str) {
+        return log_dedup_mix(key, &str, sizeof(str));
+    }
+    for (; *str; str++) {
+        key = (key ^ (uint8)*str) * 0x100000001b3ull;
+    }
+    return key;
+}
+inline uint64 log_dedup_key_arg(uint64 key, char* str) {
+    return log_dedup_key_arg(key, (const char*)str);
+}
+
+inline uint64 log_dedup_key(uint64 key) {
+    return key | 1;
+}
+template <typename T, typename... Rest>
+inline uint64 log_dedup_key(uint64 key, const T& first, const Rest&... rest) {
+    return log_dedup_key(log_dedup_key_arg(key, first), rest...);
+}
+
+// returns true if this call should log. *num_suppressed is set to how many were skipped since the last one
+RHAPI bool32 log_rate_limit_check(log_rate_limit* limit, uint32 max_per_second, uint32* num_suppressed);
+// returns true if the message with this key should be logged, false if it repeats the last one
+RHAPI bool32 log_repeat_check(log_repeat_state* state, uint64 key, log_channel Channel, log_level Level);
+// writes the repeat counts of call sites that stopped repeating over a second ago, or all of them with force
+RHAPI void log_flush_repeats(bool32 force);
+
+#define RH_LOG_RATE(Channel, Level, PerSecond, Message, ...) {                                   \
+    if (LOG_CHANNEL_ENABLED(Channel, Level)) {                                                   \
+        static log_rate_limit rh_rate_limit_;                                                    \
+        uint32 rh_num_suppressed_;                                                               \
+        if (log_rate_limit_check(&rh_rate_limit_, PerSecond, &rh_num_suppressed_)) {             \
+            LogOutputChannel(Channel, Level, Message, ##__VA_ARGS__);                            \
+            if (rh_num_suppressed_) {                                                            \
+                LogOutputChannel(Channel, Level, "(%u similar messages suppressed)", rh_num_suppressed_); \
+            }                                                                                    \
+        }                                                                                        \
+    }                                                                                            \
+}
+
+#define RH_LOG_DEDUP(Channel, Level, Message, ...) {                                             \
+    if (LOG_CHANNEL_ENABLED(Channel, Level)) {                                                   \
+        static log_repeat_state rh_repeat_state_;                                                \
+        const char* rh_format_ = Message;                                                        \
+        uint64 rh_key_ = log_dedup_key(log_dedup_mix(LOG_DEDUP_SEED, &rh_format_, sizeof(rh_format_)), ##__VA_ARGS__); \
+        if (log_repeat_check(&rh_repeat_state_, rh_key_, Channel, Level)) {                      \
+            LogOutputChannel(Channel, Level, Message, ##__VA_ARGS__);                            \
+        }                                                                                        \
+    }                                                                                            \
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Defines.h"
+
+// rank of the 99th percentile sample (nearest rank), 0-based
+inline uint32 p99_rank(uint32 count) {
+    uint32 rank = (uint32)(((uint64)count * 99 + 99) / 100);
+    return rank ? rank - 1 : 0;
+}
+
+// p99 of count samples bucketed into histogram, in bucket_size steps: the upper edge of
+// the bucket holding the p99 sample, but never past the max
+inline real32 p99_from_histogram(const uint32* histogram, uint32 num_buckets, real32 bucket_size, uint32 count, real32 max) {
+    uint32 rank = p99_rank(count);
+    uint32 seen = 0;
+    for (uint32 bucket = 0; bucket < num_buckets; bucket++) {
+        seen += histogram[bucket];
+        if (seen > rank) {
+            real32 edge = (real32)(bucket + 1) * bucket_size;
+            return (edge < max) ? edge : max;
+        }
+    }
+    return max;
+}
@@ -1,6 +1,7 @@
 #include "String.h"
 
 #include "Core/Asserts.h"
+#include "Core/Bits.h"
 #include "Memory/Memory_Arena.h"
 #include "Memory/Memory.h"
 
@@ -10,6 +11,101 @@
 #include <stdlib.h>
 #include <string.h>
 
+/*
+ * SIMD scanning:
+ *   The scanning functions compare a whole register of bytes at once and use movemask
+ *   to turn the result into a bitmask, one bit per byte. AVX2 (32 bytes) when the build
+ *   enables it (/arch:AVX2), SSE2 (16 bytes, always there on x64) otherwise.
+ *
+ *   All loads are aligned to the register width. An aligned load can never cross a page,
+ *   so reading a few bytes before the start or past the end of a buffer can't fault; those
+ *   bytes are masked off. That also means the sanitizer has to be told to look away.
+ * */
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define STRING_NO_ASAN __declspec(no_sanitize_address)
+#elif defined(__clang__) || defined(__GNUC__)
+#define STRING_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define STRING_NO_ASAN
+#endif
+
+#if defined(__AVX2__)
+#define STRING_SIMD_WIDTH 32
+typedef __m256i simd_bytes;
+STRING_NO_ASAN inline simd_bytes simd_load(const char* aligned) { return _mm256_load_si256((const __m256i*)aligned); }
+inline simd_bytes simd_splat(char c) { return _mm256_set1_epi8(c); }
+inline uint32 simd_equal(simd_bytes a, simd_bytes b) { return (uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)); }
+#define STRING_SIMD_ALL_LANES 0xFFFFFFFF
+#else
+#define STRING_SIMD_WIDTH 16
+typedef __m128i simd_bytes;
+STRING_NO_ASAN inline simd_bytes simd_load(const char* aligned) { return _mm_load_si128((const __m128i*)aligned); }
+inline simd_bytes simd_splat(char c) { return _mm_set1_epi8(c); }
+inline uint32 simd_equal(simd_bytes a, simd_bytes b) { return (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); }
+#define STRING_SIMD_ALL_LANES 0x0000FFFF
+#endif
+
+inline char* simd_align_down(char* ptr) {
+    return (char*)((uint64)ptr & ~(uint64)(STRING_SIMD_WIDTH - 1));
+}
+
+// first byte in [buffer, end) that is token (or the null-terminator, if stop_at_null), or end
+STRING_NO_ASAN internal_func char* string_scan(char* buffer, char* end, char token, bool32 stop_at_null = true) {
+    if (buffer >= end) {
+        return end;
+    }
+
+    simd_bytes tokens = simd_splat(token);
+    simd_bytes stops  = stop_at_null ? simd_splat(0) : tokens;
+
+    char* block = simd_align_down(buffer);
+    simd_bytes bytes = simd_load(block);
+    uint32 mask = (simd_equal(bytes, tokens) | simd_equal(bytes, stops)) & (STRING_SIMD_ALL_LANES << (buffer - block));
+    for (;;) {
+        if (mask) {
+            char* found = block + bit_scan_forward(mask);
+            return found < end ? found : end;
+        }
+
+        block += STRING_SIMD_WIDTH;
+        if (block >= end) {
+            return end;
+        }
+        bytes = simd_load(block);
+        mask = simd_equal(bytes, tokens) | simd_equal(bytes, stops);
+    }
+}
+
+// last token in [buffer, limit), or nullptr
+STRING_NO_ASAN internal_func char* string_scan_backward(char* buffer, char* limit, char token) {
+    if (limit <= buffer) {
+        return nullptr;
+    }
+
+    simd_bytes tokens = simd_splat(token);
+    char* block = simd_align_down(limit - 1);
+    uint32 mask = simd_equal(simd_load(block), tokens) & (uint32)(((uint64)1 << (limit - block)) - 1);
+    for (;;) {
+        if (block <= buffer) {
+            mask &= STRING_SIMD_ALL_LANES << (buffer - block);
+        }
+        if (mask) {
+            return block + bit_scan_reverse(mask);
+        }
+        if (block <= buffer) {
+            return nullptr;
+        }
+
+        block -= STRING_SIMD_WIDTH;
+        mask = simd_equal(simd_load(block), tokens);
+    }
+}
+
 uint8* AdvanceBufferSize_(uint8** Buffer, uint64 Size, uint8* End) {
     AssertMsg((*Buffer + Size) <= End, "Reached the end of the buffer!");
     uint8* Result = *Buffer;
@@ -29,13 +125,17 @@ uint64 string_copy(char* dst_buffer, uint64 dst_buf_size, char* src_buffer) {
     return num_copied;
 }
 
-uint64 string_length(char* buffer) {
-    uint64 len = 0;
-    for (char* scan = buffer; *scan; scan++) {
-        len++;
+STRING_NO_ASAN uint64 string_length(char* buffer) {
+    simd_bytes zeros = simd_splat(0);
+
+    char* block = simd_align_down(buffer);
+    uint32 mask = simd_equal(simd_load(block), zeros) & (STRING_SIMD_ALL_LANES << (buffer - block));
+    while (!mask) {
+        block += STRING_SIMD_WIDTH;
+        mask = simd_equal(simd_load(block), zeros);
     }
 
-    return len;
+    return (uint64)(block + bit_scan_forward(mask) - buffer);
 }
 
 int string_build(char* buffer, uint64 buf_size, char* fmt, ...) {
@@ -61,25 +161,28 @@ int string_compare(const char* str1, const char* str2, uint64 num_chars) {
 }
 
 char* copy_string_to_arena(const char* str, memory_arena* arena) {
-    size_t len = strlen(str);
-    char* new_str = PushArray(arena, char, len + 1);
-    memory_copy(new_str, str, len);
-    new_str[len] = 0;
+    return copy_string_to_arena(make_string_view(str), arena);
+}
+
+char* copy_string_to_arena(string_view str, memory_arena* arena) {
+    char* new_str = PushArray(arena, char, str.length + 1);
+    memory_copy(new_str, str.data, str.length);
+    new_str[str.length] = 0;
     return new_str;
 }
 
 char* get_next_line(char* buffer, char* end, uint64* line_length) {
-    for (char* scan = buffer; (scan<end) && (*scan); scan++) {
-        if (*scan == '\n') {
-            while ((scan < end) && (*scan == '\n')) {
-                scan++;
-            }
-            *line_length = string_find_first(scan, end, '\n');
-            return scan;
-        }
+    char* scan = string_scan(buffer, end, '\n');
+    if (scan == end || *scan != '\n') {
+        return nullptr;
     }
 
-    return nullptr;
+    // runs of blank lines are short, not worth a vector
+    while ((scan < end) && (*scan == '\n')) {
+        scan++;
+    }
+    *line_length = string_find_first(scan, end, '\n');
+    return scan;
 }
 
 void string_replace(char* buffer, uint64 buf_size, char replace_this, char with_this) {
@@ -90,34 +193,48 @@ void string_replace(char* buffer, uint64 buf_size, char replace_this, char with_
 }
 
 uint64 string_find_first(char* buffer, char* end, char token) {
-    for (char* scan = buffer; (scan < end) && (*scan); scan++) {
-        if (*scan == token) {
-            return (scan - buffer);
-        }
+    char* scan = string_scan(buffer, end, token);
+    if (scan < end && token && *scan == token) {
+        return (scan - buffer);
     }
     
     return (end-buffer);
 }
 
 uint64 string_find_last(char* buffer, char* end, char token) {
-    uint64 last = 0;
-    for (char* scan = buffer; (scan < end) && (*scan); scan++) {
-        if (*scan == token) {
-            last = (scan - buffer);
-        }
+    // the string stops at the null-terminator, if there is one before end
+    char* limit = string_scan(buffer, end, 0);
+    if (token == 0) {
+        return 0;
     }
-    
-    return last;
+
+    // then walk backward from there
+    char* found = string_scan_backward(buffer, limit, token);
+    return found ? (uint64)(found - buffer) : 0;
 }
 
-char* string_skip_whitespace(char* buffer, char* end) {
-    for (char* scan = buffer; (scan < end) && (*scan); scan++) {
-        if (*scan != ' ') {
-            return scan;
-        }
+STRING_NO_ASAN char* string_skip_whitespace(char* buffer, char* end) {
+    if (buffer >= end) {
+        return end;
     }
 
-    return end;
+    simd_bytes spaces = simd_splat(' ');
+
+    // bits set for anything that isn't a space (the null-terminator included)
+    char* block = simd_align_down(buffer);
+    uint32 mask = ~simd_equal(simd_load(block), spaces) & (STRING_SIMD_ALL_LANES << (buffer - block)) & STRING_SIMD_ALL_LANES;
+    for (;;) {
+        if (mask) {
+            char* found = block + bit_scan_forward(mask);
+            return (found < end && *found) ? found : end;
+        }
+
+        block += STRING_SIMD_WIDTH;
+        if (block >= end) {
+            return end;
+        }
+        mask = ~simd_equal(simd_load(block), spaces) & STRING_SIMD_ALL_LANES;
+    }
 }
 
 bool32 string_is_numeric(char* buffer, char* end) {
@@ -135,13 +252,8 @@ bool32 string_is_numeric(char* buffer, char* end) {
     return true;
 }
 bool32 string_contains(char* buffer, char* end, char token) {
-    for (char* scan = buffer; (scan < end) && (*scan); scan++) {
-        if (*scan == token) {
-            return true;
-        }
-    }
-
-    return false;
+    char* scan = string_scan(buffer, end, token);
+    return (scan < end) && token && (*scan == token);
 }
 
 bool32 string_only_whitespace(char* buffer, char* end) {
@@ -165,8 +277,158 @@ char string_first_non_whitespace_char(char* buffer, char* end) {
 }
 
 real32 string_to_float(char* buffer, uint64 length) {
-    return (real32)atof(buffer);
+    real32 value;
+    string_parse_float(buffer, length, &value);
+    return value;
 }
 int32  string_to_int(char* buffer, uint64 length) {
-    return atoi(buffer);
+    int32 value;
+    string_parse_int(buffer, length, &value);
+    return value;
+}
+
+// string_view
+inline bool32 string_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+string_view make_string_view(const char* str) {
+    string_view view;
+    view.data = str;
+    view.length = str ? string_length((char*)str) : 0;
+    return view;
+}
+
+string_view make_string_view(const char* data, uint64 length) {
+    string_view view;
+    view.data = data;
+    view.length = length;
+    return view;
+}
+
+string_view string_substring(string_view str, uint64 start, uint64 length) {
+    if (start > str.length) {
+        start = str.length;
+    }
+    if (length > str.length - start) {
+        length = str.length - start;
+    }
+    return make_string_view(str.data + start, length);
+}
+
+bool32 string_equals(string_view a, string_view b) {
+    return (a.length == b.length) && (memcmp(a.data, b.data, (size_t)a.length) == 0);
+}
+
+int string_compare(string_view a, string_view b) {
+    uint64 length = a.length < b.length ? a.length : b.length;
+    int result = memcmp(a.data, b.data, (size_t)length);
+    if (result != 0) {
+        return result;
+    }
+    if (a.length == b.length) {
+        return 0;
+    }
+    return a.length < b.length ? -1 : 1;
+}
+
+bool32 string_starts_with(string_view str, string_view prefix) {
+    return (str.length >= prefix.length) && (memcmp(str.data, prefix.data, (size_t)prefix.length) == 0);
+}
+
+bool32 string_ends_with(string_view str, string_view suffix) {
+    return (str.length >= suffix.length) &&
+           (memcmp(str.data + str.length - suffix.length, suffix.data, (size_t)suffix.length) == 0);
+}
+
+uint64 string_find_first(string_view str, char token) {
+    char* start = (char*)str.data;
+    return (uint64)(string_scan(start, start + str.length, token, false) - start);
+}
+
+uint64 string_find_last(string_view str, char token) {
+    char* start = (char*)str.data;
+    char* found = string_scan_backward(start, start + str.length, token);
+    return found ? (uint64)(found - start) : str.length;
+}
+
+uint64 string_find(string_view str, string_view needle) {
+    if (needle.length == 0) {
+        return 0;
+    }
+    if (needle.length > str.length) {
+        return str.length;
+    }
+
+    // find candidates by their first char, then compare the rest
+    char* start = (char*)str.data;
+    char* last  = start + (str.length - needle.length) + 1;
+    char* scan  = start;
+    for (;;) {
+        scan = string_scan(scan, last, needle.data[0], false);
+        if (scan >= last) {
+            return str.length;
+        }
+        if (memcmp(scan + 1, needle.data + 1, (size_t)needle.length - 1) == 0) {
+            return (uint64)(scan - start);
+        }
+        scan++;
+    }
+}
+
+bool32 string_contains(string_view str, char token) {
+    return string_find_first(str, token) < str.length;
+}
+
+string_view string_trim_left(string_view str) {
+    uint64 start = 0;
+    while (start < str.length && string_is_space(str.data[start])) {
+        start++;
+    }
+    return make_string_view(str.data + start, str.length - start);
+}
+
+string_view string_trim_right(string_view str) {
+    uint64 length = str.length;
+    while (length > 0 && string_is_space(str.data[length - 1])) {
+        length--;
+    }
+    return make_string_view(str.data, length);
+}
+
+string_view string_trim(string_view str) {
+    return string_trim_right(string_trim_left(str));
+}
+
+bool32 string_split(string_view* remaining, char delimiter, string_view* token) {
+    if (remaining->data == nullptr) {
+        return false;
+    }
+
+    uint64 index = string_find_first(*remaining, delimiter);
+    *token = make_string_view(remaining->data, index);
+    if (index < remaining->length) {
+        *remaining = make_string_view(remaining->data + index + 1, remaining->length - index - 1);
+    } else {
+        // that was the last token
+        *remaining = make_string_view(nullptr, 0);
+    }
+    return true;
+}
+
+bool32 string_next_line(string_view* remaining, string_view* line) {
+    if (remaining->length == 0) {
+        return false;
+    }
+
+    uint64 index = string_find_first(*remaining, '\n');
+    uint64 length = index;
+    if (length > 0 && remaining->data[length - 1] == '\r') {
+        length--;
+    }
+    *line = make_string_view(remaining->data, length);
+
+    uint64 consumed = (index < remaining->length) ? index + 1 : index;
+    *remaining = make_string_view(remaining->data + consumed, remaining->length - consumed);
+    return true;
 }
\ No newline at end of file
@@ -4,6 +4,12 @@
 
 struct memory_arena;
 
+// a run of chars with an explicit length. not null-terminated, doesn't own anything.
+struct string_view {
+    const char* data;
+    uint64 length;
+};
+
 // buffer reading utils
 #define AdvanceBufferArray(Buffer, Type, Count, End) (Type*)AdvanceBufferSize_(Buffer, (Count)*sizeof(Type), End)
 #define AdvanceBuffer(Buffer, Type, End) (Type*)AdvanceBufferSize_(Buffer, sizeof(Type), End)
@@ -15,6 +21,7 @@ RHAPI int string_build(char* buffer, uint64 buf_size, char* fmt, ...);
 RHAPI int string_compare(const char* str1, const char* str2);
 RHAPI int string_compare(const char* str1, const char* str2, uint64 num_chars);
 RHAPI char* copy_string_to_arena(const char* str, memory_arena* arena);
+RHAPI char* copy_string_to_arena(string_view str, memory_arena* arena);
 
 RHAPI char* get_next_line(char* buffer, char* end, uint64* line_length);
 RHAPI void string_replace(char* buffer, uint64 buf_size, char replace_this, char with_this);
@@ -29,3 +36,51 @@ RHAPI char string_first_non_whitespace_char(char* buffer, char* end);
 
 RHAPI real32 string_to_float(char* buffer, uint64 length);
 RHAPI int32  string_to_int(char* buffer, uint64 length);
+
+// parse one number from at most length chars (skipping leading whitespace).
+// returns the number of chars consumed, 0 if there wasn't a number there.
+RHAPI uint64 string_parse_float(const char* buffer, uint64 length, real32* value);
+RHAPI uint64 string_parse_int(const char* buffer, uint64 length, int32* value);
+// parse up to max_values numbers separated by whitespace and/or commas. returns how many were parsed
+RHAPI uint64 string_parse_floats(const char* buffer, uint64 length, real32* values, uint64 max_values, uint64* chars_consumed);
+RHAPI uint64 string_parse_ints(const char* buffer, uint64 length, int32* values, uint64 max_values, uint64* chars_consumed);
+
+
+/*
+ * string_view versions:
+ *   Nothing here looks for a null-terminator or recomputes a length, embedded zeroes are just chars.
+ *   Finds return str.length when the token isn't there.
+ * */
+RHAPI string_view make_string_view(const char* str); // the one place a length gets counted
+RHAPI string_view make_string_view(const char* data, uint64 length);
+RHAPI string_view string_substring(string_view str, uint64 start, uint64 length);
+
+RHAPI bool32 string_equals(string_view a, string_view b);
+RHAPI int    string_compare(string_view a, string_view b);
+RHAPI bool32 string_starts_with(string_view str, string_view prefix);
+RHAPI bool32 string_ends_with(string_view str, string_view suffix);
+
+RHAPI uint64 string_find_first(string_view str, char token);
+RHAPI uint64 string_find_last(string_view str, char token);
+RHAPI uint64 string_find(string_view str, string_view needle);
+RHAPI bool32 string_contains(string_view str, char token);
+
+// trims spaces, tabs, and line endings
+RHAPI string_view string_trim_left(string_view str);
+RHAPI string_view string_trim_right(string_view str);
+RHAPI string_view string_trim(string_view str);
+
+// pulls the next token off the front of remaining, up to the delimiter. empty tokens are kept.
+// returns false once everything has been handed out:
+//   string_view token;
+//   while (string_split(&remaining, ',', &token)) { ... }
+RHAPI bool32 string_split(string_view* remaining, char delimiter, string_view* token);
+// same idea, one line at a time. line doesn't include the '\n' (or a '\r' before it)
+RHAPI bool32 string_next_line(string_view* remaining, string_view* line);
+
+inline uint64 string_parse_float(string_view str, real32* value) {
+    return string_parse_float(str.data, str.length, value);
+}
+inline uint64 string_parse_int(string_view str, int32* value) {
+    return string_parse_int(str.data, str.length, value);
+}
@@ -0,0 +1,174 @@
+#include "String_Benchmark.h"
+
+#include "Core/Logger.h"
+#include "Core/String.h"
+#include "Memory/Memory.h"
+#include "Platform/Platform.h"
+
+#define STRING_BENCH_DEFAULT_BYTES Megabytes(8)
+#define STRING_BENCH_REPEATS       5 // best of
+#define STRING_BENCH_MAX_LINE      120
+
+#if defined(__AVX2__)
+#define STRING_BENCH_SIMD_NAME "AVX2"
+#else
+#define STRING_BENCH_SIMD_NAME "SSE2"
+#endif
+
+enum string_bench_test {
+    STRING_BENCH_LENGTH,
+    STRING_BENCH_FIND_FIRST,
+    STRING_BENCH_FIND_LAST,
+    STRING_BENCH_LINES,
+
+    STRING_BENCH_NUM_TESTS
+};
+
+global_variable const char* string_bench_test_names[STRING_BENCH_NUM_TESTS] = {
+    "string_length", "string_find_first", "string_find_last", "get_next_line"
+};
+
+// the byte-at-a-time versions the SIMD ones replaced.
+// string_length gets an end too, or the compiler swaps the loop for a call to strlen
+internal_func uint64 scalar_string_length(char* buffer, char* end) {
+    uint64 len = 0;
+    for (char* scan = buffer; (scan < end) && (*scan); scan++) {
+        len++;
+    }
+    return len;
+}
+
+internal_func uint64 scalar_find_first(char* buffer, char* end, char token) {
+    for (char* scan = buffer; (scan < end) && (*scan); scan++) {
+        if (*scan == token) {
+            return (scan - buffer);
+        }
+    }
+    return (end-buffer);
+}
+
+internal_func uint64 scalar_find_last(char* buffer, char* end, char token) {
+    uint64 last = 0;
+    for (char* scan = buffer; (scan < end) && (*scan); scan++) {
+        if (*scan == token) {
+            last = (scan - buffer);
+        }
+    }
+    return last;
+}
+
+internal_func char* scalar_get_next_line(char* buffer, char* end, uint64* line_length) {
+    for (char* scan = buffer; (scan<end) && (*scan); scan++) {
+        if (*scan == '\n') {
+            while ((scan < end) && (*scan == '\n')) {
+                scan++;
+            }
+            *line_length = scalar_find_first(scan, end, '\n');
+            return scan;
+        }
+    }
+    return nullptr;
+}
+
+// returns something that depends on the whole scan, so none of it can be skipped
+internal_func uint64 string_bench_once(string_bench_test test, bool32 simd, char* buffer, char* end) {
+    switch (test) {
+        case STRING_BENCH_LENGTH: {
+            return simd ? string_length(buffer) : scalar_string_length(buffer, end + 1);
+        }
+        case STRING_BENCH_FIND_FIRST: {
+            return simd ? string_find_first(buffer, end, '#') : scalar_find_first(buffer, end, '#');
+        }
+        case STRING_BENCH_FIND_LAST: {
+            return simd ? string_find_last(buffer, end, '@') : scalar_find_last(buffer, end, '@');
+        }
+        case STRING_BENCH_LINES: {
+            uint64 total = 0;
+            uint64 line_length = 0;
+            char* line = buffer;
+            while (line) {
+                line = simd ? get_next_line(line, end, &line_length) : scalar_get_next_line(line, end, &line_length);
+                total += line_length;
+            }
+            return total;
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+// GB/s
+internal_func real64 string_bench_test_run(string_bench_test test, bool32 simd, char* buffer, char* end, uint64* result) {
+    real64 best = 0.0;
+    for (uint32 repeat = 0; repeat < STRING_BENCH_REPEATS; repeat++) {
+        int64 start = platform_get_wall_clock();
+        *result = string_bench_once(test, simd, buffer, end);
+        real64 seconds = platform_get_seconds_elapsed(start, platform_get_wall_clock());
+        if (repeat == 0 || seconds < best) {
+            best = seconds;
+        }
+    }
+    return (best > 0.0) ? (real64)(end - buffer) / best * 1.0e-9 : 0.0;
+}
+
+// words of 1-10 lowercase letters, separated by spaces, in lines of up to STRING_BENCH_MAX_LINE
+internal_func void string_bench_fill(char* buffer, uint64 num_bytes) {
+    uint32 rng = 0x12345678;
+    uint64 line_start = 0;
+    uint64 n = 0;
+    while (n < num_bytes) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+
+        uint64 word_length = 1 + (rng % 10);
+        for (uint64 c = 0; c < word_length && n < num_bytes; c++) {
+            buffer[n++] = (char)('a' + ((rng >> (c*3)) % 26));
+        }
+        if (n < num_bytes) {
+            bool32 end_line = (n - line_start > STRING_BENCH_MAX_LINE - 12) || (rng >> 28) == 0;
+            buffer[n++] = end_line ? '\n' : ' ';
+            if (end_line) {
+                line_start = n;
+            }
+        }
+    }
+}
+
+void string_benchmark_run(uint64 num_bytes) {
+    if (num_bytes == 0) {
+        num_bytes = STRING_BENCH_DEFAULT_BYTES;
+    }
+    if (num_bytes < 16) {
+        num_bytes = 16;
+    }
+
+    // +1 for the null-terminator
+    char* buffer = (char*)platform_alloc(num_bytes + 1, 0);
+    if (!buffer) {
+        RH_ERROR("Could not allocate %.2f MB for the string benchmark", (real64)num_bytes / (real64)Megabytes(1));
+        return;
+    }
+    string_bench_fill(buffer, num_bytes);
+    buffer[8] = '@';             // the only one, near the start
+    buffer[num_bytes - 1] = '#'; // the only one, at the end
+    buffer[num_bytes] = 0;
+    char* end = buffer + num_bytes;
+
+    RH_INFO("String scanning benchmark: %.2f MB of text, scalar vs " STRING_BENCH_SIMD_NAME,
+            (real64)num_bytes / (real64)Megabytes(1));
+    for (uint32 test = 0; test < STRING_BENCH_NUM_TESTS; test++) {
+        uint64 scalar_result = 0;
+        uint64 simd_result = 0;
+        real64 scalar_gbs = string_bench_test_run((string_bench_test)test, false, buffer, end, &scalar_result);
+        real64 simd_gbs   = string_bench_test_run((string_bench_test)test, true,  buffer, end, &simd_result);
+
+        RH_INFO("  %-18s scalar %6.2f GB/s, " STRING_BENCH_SIMD_NAME " %6.2f GB/s, %5.1fx%s",
+                string_bench_test_names[test], scalar_gbs, simd_gbs,
+                (scalar_gbs > 0.0) ? simd_gbs / scalar_gbs : 0.0,
+                (scalar_result == simd_result) ? "" : " (results differ!)");
+    }
+
+    platform_free(buffer);
+}
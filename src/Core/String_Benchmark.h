@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Defines.h"
+
+/*
+ * String scanning benchmark:
+ *   Fills num_bytes of made-up text (words, spaces and short lines, like a text asset),
+ *   and logs the throughput of the SIMD scanning functions in String.h next to plain
+ *   byte-at-a-time loops doing the same thing:
+ *     - string_length over the whole buffer
+ *     - string_find_first for a char that's only at the very end
+ *     - string_find_last for a char that's only near the start
+ *     - walking every line with get_next_line
+ *
+ *   num_bytes of 0 is 8 MB. Each result is the best of a few runs.
+ * */
+
+RHAPI void string_benchmark_run(uint64 num_bytes);
@@ -0,0 +1,192 @@
+#include "String_Builder.h"
+
+#include "Core/Asserts.h"
+#include "Memory/Memory_Arena.h"
+#include "Memory/Memory.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#define STRING_BUILDER_MAX_DECIMALS 9
+
+// "00" "01" ... "99", so ints are written two digits at a time
+global_variable const char string_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+void string_builder_begin(string_builder* builder, memory_arena* arena, uint64 initial_capacity) {
+    builder->arena    = arena;
+    builder->length   = 0;
+    builder->capacity = initial_capacity > 0 ? initial_capacity : 1;
+    builder->data     = PushArray(arena, char, builder->capacity);
+}
+
+void string_builder_reserve(string_builder* builder, uint64 num_chars) {
+    uint64 needed = builder->length + num_chars + 1; // always leave room for the null-terminator
+    if (needed <= builder->capacity) {
+        return;
+    }
+
+    uint64 new_capacity = builder->capacity*2;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    memory_arena* arena = builder->arena;
+    uint8* top = arena->Base + arena->Used;
+    if ((uint8*)builder->data + builder->capacity == top &&
+        arena->Used + (new_capacity - builder->capacity) <= arena->Size) {
+        // nothing else was pushed since, grow in place
+        PushSize_(arena, new_capacity - builder->capacity);
+    } else {
+        char* new_data = PushArray(arena, char, new_capacity);
+        memory_copy(new_data, builder->data, builder->length);
+        builder->data = new_data;
+    }
+    builder->capacity = new_capacity;
+}
+
+string_view string_builder_finish(string_builder* builder) {
+    string_builder_reserve(builder, 0);
+    builder->data[builder->length] = 0;
+
+    // hand back what wasn't used, if we're still on top of the arena
+    memory_arena* arena = builder->arena;
+    if ((uint8*)builder->data + builder->capacity == arena->Base + arena->Used) {
+        arena->Used -= builder->capacity - (builder->length + 1);
+        builder->capacity = builder->length + 1;
+    }
+
+    return make_string_view(builder->data, builder->length);
+}
+
+void string_append(string_builder* builder, string_view str) {
+    string_builder_reserve(builder, str.length);
+    memory_copy(builder->data + builder->length, str.data, str.length);
+    builder->length += str.length;
+}
+
+void string_append(string_builder* builder, const char* str) {
+    string_append(builder, make_string_view(str));
+}
+
+void string_append_char(string_builder* builder, char c) {
+    string_builder_reserve(builder, 1);
+    builder->data[builder->length++] = c;
+}
+
+// writes the digits of value ending at end, returns where they start
+internal_func char* string_format_uint(char* end, uint64 value) {
+    char* scan = end;
+    while (value >= 100) {
+        uint64 pair = (value % 100)*2;
+        value /= 100;
+        scan -= 2;
+        scan[0] = string_digit_pairs[pair];
+        scan[1] = string_digit_pairs[pair + 1];
+    }
+    if (value >= 10) {
+        scan -= 2;
+        scan[0] = string_digit_pairs[value*2];
+        scan[1] = string_digit_pairs[value*2 + 1];
+    } else {
+        *--scan = (char)('0' + value);
+    }
+    return scan;
+}
+
+void string_append_uint(string_builder* builder, uint64 value) {
+    char digits[20];
+    char* start = string_format_uint(digits + sizeof(digits), value);
+    string_append(builder, make_string_view(start, (uint64)(digits + sizeof(digits) - start)));
+}
+
+void string_append_int(string_builder* builder, int64 value) {
+    if (value < 0) {
+        string_append_char(builder, '-');
+        string_append_uint(builder, 0 - (uint64)value); // works for INT64_MIN too
+    } else {
+        string_append_uint(builder, (uint64)value);
+    }
+}
+
+void string_append_float(string_builder* builder, real64 value, uint32 decimals) {
+    if (decimals > STRING_BUILDER_MAX_DECIMALS) {
+        decimals = STRING_BUILDER_MAX_DECIMALS;
+    }
+
+    if (value != value) {
+        string_append(builder, make_string_view("nan", 3));
+        return;
+    }
+
+    bool32 negative = value < 0.0;
+    real64 magnitude = negative ? -value : value;
+
+    const uint64 powers_of_ten[STRING_BUILDER_MAX_DECIMALS + 1] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+    };
+    real64 scaled = magnitude*(real64)powers_of_ten[decimals];
+    if (scaled >= 9007199254740992.0) {
+        // past 2^53 the fixed-point trick stops being exact (and catches inf), let printf do it
+        string_append_format(builder, "%.*f", (int)decimals, value);
+        return;
+    }
+
+    // round half to even, like printf. (the scale itself can round, so the last digit
+    // can still come out different from printf very close to a tie)
+    uint64 fixed = (uint64)scaled;
+    real64 remainder = scaled - (real64)fixed;
+    if (remainder > 0.5 || (remainder == 0.5 && (fixed & 1))) {
+        fixed++;
+    }
+    uint64 whole = fixed / powers_of_ten[decimals];
+    uint64 fraction = fixed % powers_of_ten[decimals];
+
+    if (negative && fixed != 0) {
+        string_append_char(builder, '-');
+    }
+    string_append_uint(builder, whole);
+
+    if (decimals > 0) {
+        string_builder_reserve(builder, decimals + 1);
+        builder->data[builder->length++] = '.';
+
+        // fraction digits, zero-padded on the left
+        char* end = builder->data + builder->length + decimals;
+        char* start = string_format_uint(end, fraction);
+        for (char* pad = builder->data + builder->length; pad < start; pad++) {
+            *pad = '0';
+        }
+        builder->length += decimals;
+    }
+}
+
+void string_append_format(string_builder* builder, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    // try with what's left, and if it didn't fit grow to the exact size and go again
+    uint64 available = builder->capacity - builder->length;
+    int written = vsnprintf(builder->data + builder->length, (size_t)available, fmt, args);
+    if (written > 0) {
+        if ((uint64)written >= available) {
+            string_builder_reserve(builder, (uint64)written);
+            vsnprintf(builder->data + builder->length, (size_t)written + 1, fmt, args_copy);
+        }
+        builder->length += (uint64)written;
+    }
+
+    va_end(args_copy);
+    va_end(args);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/String.h"
+
+struct memory_arena;
+
+/*
+ * String builder:
+ *   Appends into memory from an arena, so there's no fixed-size buffer to overflow.
+ *   While the builder's buffer is the last thing pushed onto the arena it grows in place,
+ *   otherwise it moves to a new block twice the size (the old one is left for the arena
+ *   to reclaim on reset).
+ *
+ *   Ints and floats are formatted without going through printf.
+ *   string_builder_finish null-terminates the result, gives back any unused capacity, and
+ *   returns a view of it. The chars live as long as the arena does.
+ *
+ *     string_builder builder;
+ *     string_builder_begin(&builder, &frame_arena);
+ *     string_append(&builder, "FPS: ");
+ *     string_append_float(&builder, fps, 2);
+ *     string_view title = string_builder_finish(&builder);
+ * */
+struct string_builder {
+    memory_arena* arena;
+    char* data;
+    uint64 length;
+    uint64 capacity;
+};
+
+RHAPI void string_builder_begin(string_builder* builder, memory_arena* arena, uint64 initial_capacity = 64);
+RHAPI string_view string_builder_finish(string_builder* builder);
+// makes sure there's room for num_chars more (plus the null-terminator)
+RHAPI void string_builder_reserve(string_builder* builder, uint64 num_chars);
+
+RHAPI void string_append(string_builder* builder, string_view str);
+RHAPI void string_append(string_builder* builder, const char* str);
+RHAPI void string_append_char(string_builder* builder, char c);
+RHAPI void string_append_int(string_builder* builder, int64 value);
+RHAPI void string_append_uint(string_builder* builder, uint64 value);
+// fixed-point, with the given number of decimals (at most 9). matches %.*f except maybe the
+// last digit of a near-tie
+RHAPI void string_append_float(string_builder* builder, real64 value, uint32 decimals = 3);
+// anything else still goes through vsnprintf, but straight into the builder
+RHAPI void string_append_format(string_builder* builder, const char* fmt, ...);
@@ -0,0 +1,474 @@
+#include "String.h"
+#include "Core/Bits.h"
+
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+ * Number parsing:
+ *   Length-bounded, allocation-free, and independent of the locale.
+ *
+ *   Floats are correctly rounded (round-to-nearest-even), following Eisel-Lemire:
+ *     - up to 19 significant digits are gathered into a uint64 w, with a decimal exponent q.
+ *     - small w and q are exact in float math (Clinger's fast path).
+ *     - otherwise w is multiplied by a 128-bit truncated 5^q from the table below, and the top
+ *       bits of the product give the float mantissa. For binary32 that product is always
+ *       enough to round correctly.
+ *     - with more than 19 significant digits, w and w+1 are both tried. If they round to
+ *       different floats, the (rare) answer comes from strtof on a copy of the token.
+ * */
+
+#define PARSE_MAX_DIGITS 19
+
+// float32 layout
+#define FLOAT_MANTISSA_BITS 23
+#define FLOAT_MIN_EXPONENT  -127
+#define FLOAT_INFINITE_POWER 0xFF
+
+// anything below 1e-65 is zero, and above 1e38 is infinite, no matter the digits
+#define FLOAT_SMALLEST_POWER_OF_TEN -65
+#define FLOAT_LARGEST_POWER_OF_TEN   38
+
+// products this close to halfway can only be exact ties for these exponents
+#define FLOAT_MIN_EXPONENT_ROUND_TO_EVEN -17
+#define FLOAT_MAX_EXPONENT_ROUND_TO_EVEN  10
+
+// 128-bit 5^q for q in [FLOAT_SMALLEST_POWER_OF_TEN, FLOAT_LARGEST_POWER_OF_TEN],
+// normalized so the top bit is set. (high 64 bits, low 64 bits)
+global_variable const uint64 power_of_five_128[] = {
+    0x86ccbb52ea94baea, 0x98e947129fc2b4e9, // 5^-65
+    0xa87fea27a539e9a5, 0x3f2398d747b36224, // 5^-64
+    0xd29fe4b18e88640e, 0x8eec7f0d19a03aad, // 5^-63
+    0x83a3eeeef9153e89, 0x1953cf68300424ac, // 5^-62
+    0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7, // 5^-61
+    0xcdb02555653131b6, 0x3792f412cb06794d, // 5^-60
+    0x808e17555f3ebf11, 0xe2bbd88bbee40bd0, // 5^-59
+    0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4, // 5^-58
+    0xc8de047564d20a8b, 0xf245825a5a445275, // 5^-57
+    0xfb158592be068d2e, 0xeed6e2f0f0d56712, // 5^-56
+    0x9ced737bb6c4183d, 0x55464dd69685606b, // 5^-55
+    0xc428d05aa4751e4c, 0xaa97e14c3c26b886, // 5^-54
+    0xf53304714d9265df, 0xd53dd99f4b3066a8, // 5^-53
+    0x993fe2c6d07b7fab, 0xe546a8038efe4029, // 5^-52
+    0xbf8fdb78849a5f96, 0xde98520472bdd033, // 5^-51
+    0xef73d256a5c0f77c, 0x963e66858f6d4440, // 5^-50
+    0x95a8637627989aad, 0xdde7001379a44aa8, // 5^-49
+    0xbb127c53b17ec159, 0x5560c018580d5d52, // 5^-48
+    0xe9d71b689dde71af, 0xaab8f01e6e10b4a6, // 5^-47
+    0x9226712162ab070d, 0xcab3961304ca70e8, // 5^-46
+    0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22, // 5^-45
+    0xe45c10c42a2b3b05, 0x8cb89a7db77c506a, // 5^-44
+    0x8eb98a7a9a5b04e3, 0x77f3608e92adb242, // 5^-43
+    0xb267ed1940f1c61c, 0x55f038b237591ed3, // 5^-42
+    0xdf01e85f912e37a3, 0x6b6c46dec52f6688, // 5^-41
+    0x8b61313bbabce2c6, 0x2323ac4b3b3da015, // 5^-40
+    0xae397d8aa96c1b77, 0xabec975e0a0d081a, // 5^-39
+    0xd9c7dced53c72255, 0x96e7bd358c904a21, // 5^-38
+    0x881cea14545c7575, 0x7e50d64177da2e54, // 5^-37
+    0xaa242499697392d2, 0xdde50bd1d5d0b9e9, // 5^-36
+    0xd4ad2dbfc3d07787, 0x955e4ec64b44e864, // 5^-35
+    0x84ec3c97da624ab4, 0xbd5af13bef0b113e, // 5^-34
+    0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e, // 5^-33
+    0xcfb11ead453994ba, 0x67de18eda5814af2, // 5^-32
+    0x81ceb32c4b43fcf4, 0x80eacf948770ced7, // 5^-31
+    0xa2425ff75e14fc31, 0xa1258379a94d028d, // 5^-30
+    0xcad2f7f5359a3b3e, 0x096ee45813a04330, // 5^-29
+    0xfd87b5f28300ca0d, 0x8bca9d6e188853fc, // 5^-28
+    0x9e74d1b791e07e48, 0x775ea264cf55347e, // 5^-27
+    0xc612062576589dda, 0x95364afe032a819e, // 5^-26
+    0xf79687aed3eec551, 0x3a83ddbd83f52205, // 5^-25
+    0x9abe14cd44753b52, 0xc4926a9672793543, // 5^-24
+    0xc16d9a0095928a27, 0x75b7053c0f178294, // 5^-23
+    0xf1c90080baf72cb1, 0x5324c68b12dd6339, // 5^-22
+    0x971da05074da7bee, 0xd3f6fc16ebca5e04, // 5^-21
+    0xbce5086492111aea, 0x88f4bb1ca6bcf585, // 5^-20
+    0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6, // 5^-19
+    0x9392ee8e921d5d07, 0x3aff322e62439fd0, // 5^-18
+    0xb877aa3236a4b449, 0x09befeb9fad487c3, // 5^-17
+    0xe69594bec44de15b, 0x4c2ebe687989a9b4, // 5^-16
+    0x901d7cf73ab0acd9, 0x0f9d37014bf60a11, // 5^-15
+    0xb424dc35095cd80f, 0x538484c19ef38c95, // 5^-14
+    0xe12e13424bb40e13, 0x2865a5f206b06fba, // 5^-13
+    0x8cbccc096f5088cb, 0xf93f87b7442e45d4, // 5^-12
+    0xafebff0bcb24aafe, 0xf78f69a51539d749, // 5^-11
+    0xdbe6fecebdedd5be, 0xb573440e5a884d1c, // 5^-10
+    0x89705f4136b4a597, 0x31680a88f8953031, // 5^-9
+    0xabcc77118461cefc, 0xfdc20d2b36ba7c3e, // 5^-8
+    0xd6bf94d5e57a42bc, 0x3d32907604691b4d, // 5^-7
+    0x8637bd05af6c69b5, 0xa63f9a49c2c1b110, // 5^-6
+    0xa7c5ac471b478423, 0x0fcf80dc33721d54, // 5^-5
+    0xd1b71758e219652b, 0xd3c36113404ea4a9, // 5^-4
+    0x83126e978d4fdf3b, 0x645a1cac083126ea, // 5^-3
+    0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4, // 5^-2
+    0xcccccccccccccccc, 0xcccccccccccccccd, // 5^-1
+    0x8000000000000000, 0x0000000000000000, // 5^0
+    0xa000000000000000, 0x0000000000000000, // 5^1
+    0xc800000000000000, 0x0000000000000000, // 5^2
+    0xfa00000000000000, 0x0000000000000000, // 5^3
+    0x9c40000000000000, 0x0000000000000000, // 5^4
+    0xc350000000000000, 0x0000000000000000, // 5^5
+    0xf424000000000000, 0x0000000000000000, // 5^6
+    0x9896800000000000, 0x0000000000000000, // 5^7
+    0xbebc200000000000, 0x0000000000000000, // 5^8
+    0xee6b280000000000, 0x0000000000000000, // 5^9
+    0x9502f90000000000, 0x0000000000000000, // 5^10
+    0xba43b74000000000, 0x0000000000000000, // 5^11
+    0xe8d4a51000000000, 0x0000000000000000, // 5^12
+    0x9184e72a00000000, 0x0000000000000000, // 5^13
+    0xb5e620f480000000, 0x0000000000000000, // 5^14
+    0xe35fa931a0000000, 0x0000000000000000, // 5^15
+    0x8e1bc9bf04000000, 0x0000000000000000, // 5^16
+    0xb1a2bc2ec5000000, 0x0000000000000000, // 5^17
+    0xde0b6b3a76400000, 0x0000000000000000, // 5^18
+    0x8ac7230489e80000, 0x0000000000000000, // 5^19
+    0xad78ebc5ac620000, 0x0000000000000000, // 5^20
+    0xd8d726b7177a8000, 0x0000000000000000, // 5^21
+    0x878678326eac9000, 0x0000000000000000, // 5^22
+    0xa968163f0a57b400, 0x0000000000000000, // 5^23
+    0xd3c21bcecceda100, 0x0000000000000000, // 5^24
+    0x84595161401484a0, 0x0000000000000000, // 5^25
+    0xa56fa5b99019a5c8, 0x0000000000000000, // 5^26
+    0xcecb8f27f4200f3a, 0x0000000000000000, // 5^27
+    0x813f3978f8940984, 0x4000000000000000, // 5^28
+    0xa18f07d736b90be5, 0x5000000000000000, // 5^29
+    0xc9f2c9cd04674ede, 0xa400000000000000, // 5^30
+    0xfc6f7c4045812296, 0x4d00000000000000, // 5^31
+    0x9dc5ada82b70b59d, 0xf020000000000000, // 5^32
+    0xc5371912364ce305, 0x6c28000000000000, // 5^33
+    0xf684df56c3e01bc6, 0xc732000000000000, // 5^34
+    0x9a130b963a6c115c, 0x3c7f400000000000, // 5^35
+    0xc097ce7bc90715b3, 0x4b9f100000000000, // 5^36
+    0xf0bdc21abb48db20, 0x1e86d40000000000, // 5^37
+    0x96769950b50d88f4, 0x1314448000000000, // 5^38
+};
+
+struct parse_uint128 {
+    uint64 low;
+    uint64 high;
+};
+
+inline parse_uint128 parse_multiply(uint64 a, uint64 b) {
+    parse_uint128 result;
+#if defined(_MSC_VER)
+    result.low = _umul128(a, b, &result.high);
+#else
+    unsigned __int128 product = (unsigned __int128)a * b;
+    result.low  = (uint64)product;
+    result.high = (uint64)(product >> 64);
+#endif
+    return result;
+}
+
+// w must be non-zero
+inline int32 parse_leading_zeroes(uint64 w) {
+    return 63 - (int32)bit_scan_reverse64(w);
+}
+
+inline bool32 parse_is_digit(char c) {
+    return (uint8)(c - '0') < 10;
+}
+
+inline bool32 parse_is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+struct parsed_decimal {
+    uint64 w;         // first PARSE_MAX_DIGITS significant digits
+    int64  q;         // value = w * 10^q
+    bool32 negative;
+    bool32 truncated; // non-zero digits were dropped past PARSE_MAX_DIGITS
+};
+
+// [+-]digits[.digits][(e|E)[+-]digits]. returns the number of chars used, 0 if it isn't a number
+internal_func uint64 parse_decimal(const char* start, const char* end, parsed_decimal* result) {
+    const char* scan = start;
+    result->w = 0;
+    result->q = 0;
+    result->negative = false;
+    result->truncated = false;
+
+    if (scan < end && (*scan == '-' || *scan == '+')) {
+        result->negative = (*scan == '-');
+        scan++;
+    }
+
+    uint32 num_digits = 0;     // significant digits kept in w
+    bool32 any_digits = false;
+
+    // integer part
+    while (scan < end && parse_is_digit(*scan)) {
+        uint8 digit = (uint8)(*scan - '0');
+        if (num_digits < PARSE_MAX_DIGITS) {
+            result->w = result->w*10 + digit;
+            if (result->w) {
+                num_digits++; // leading zeroes don't count
+            }
+        } else {
+            result->q++;
+            result->truncated |= (digit != 0);
+        }
+        any_digits = true;
+        scan++;
+    }
+
+    // fractional part
+    if (scan < end && *scan == '.') {
+        scan++;
+        while (scan < end && parse_is_digit(*scan)) {
+            uint8 digit = (uint8)(*scan - '0');
+            if (num_digits < PARSE_MAX_DIGITS) {
+                result->w = result->w*10 + digit;
+                result->q--;
+                if (result->w) {
+                    num_digits++;
+                }
+            } else {
+                result->truncated |= (digit != 0);
+            }
+            any_digits = true;
+            scan++;
+        }
+    }
+
+    if (!any_digits) {
+        return 0;
+    }
+
+    // exponent, only if there are digits after the 'e'
+    if (scan < end && (*scan == 'e' || *scan == 'E')) {
+        const char* exponent_scan = scan + 1;
+        bool32 negative_exponent = false;
+        if (exponent_scan < end && (*exponent_scan == '-' || *exponent_scan == '+')) {
+            negative_exponent = (*exponent_scan == '-');
+            exponent_scan++;
+        }
+
+        if (exponent_scan < end && parse_is_digit(*exponent_scan)) {
+            int64 exponent = 0;
+            while (exponent_scan < end && parse_is_digit(*exponent_scan)) {
+                if (exponent < 100000) {
+                    exponent = exponent*10 + (*exponent_scan - '0');
+                }
+                exponent_scan++;
+            }
+            result->q += negative_exponent ? -exponent : exponent;
+            scan = exponent_scan;
+        }
+    }
+
+    return (uint64)(scan - start);
+}
+
+// Eisel-Lemire. returns the bits of the (positive) float closest to w * 10^q
+internal_func uint32 parse_compute_float(int64 q, uint64 w) {
+    if (w == 0 || q < FLOAT_SMALLEST_POWER_OF_TEN) {
+        return 0;
+    }
+    if (q > FLOAT_LARGEST_POWER_OF_TEN) {
+        return (uint32)FLOAT_INFINITE_POWER << FLOAT_MANTISSA_BITS;
+    }
+
+    int32 lz = parse_leading_zeroes(w);
+    w <<= lz;
+
+    // only need the top FLOAT_MANTISSA_BITS+3 bits of w*5^q to be exact
+    const uint64 precision_mask = 0xFFFFFFFFFFFFFFFF >> (FLOAT_MANTISSA_BITS + 3);
+    uint32 index = 2*(uint32)(q - FLOAT_SMALLEST_POWER_OF_TEN);
+    parse_uint128 product = parse_multiply(w, power_of_five_128[index]);
+    if ((product.high & precision_mask) == precision_mask) {
+        // the low bits might carry into the ones we care about
+        parse_uint128 second = parse_multiply(w, power_of_five_128[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            product.high++;
+        }
+    }
+
+    int32 upper_bit = (int32)(product.high >> 63);
+    int32 shift = upper_bit + 64 - FLOAT_MANTISSA_BITS - 3;
+    uint64 mantissa = product.high >> shift;
+
+    // floor(log2(10^q)) + 63, the binary exponent of the product
+    int32 power2 = (int32)((((152170 + 65536) * q) >> 16) + 63) + upper_bit - lz - FLOAT_MIN_EXPONENT;
+
+    if (power2 <= 0) {
+        // subnormal
+        if (-power2 + 1 >= 64) {
+            return 0;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += (mantissa & 1);
+        mantissa >>= 1;
+        // rounding up can make it a normal number again
+        power2 = (mantissa < ((uint64)1 << FLOAT_MANTISSA_BITS)) ? 0 : 1;
+        return ((uint32)power2 << FLOAT_MANTISSA_BITS) | (uint32)(mantissa & (((uint64)1 << FLOAT_MANTISSA_BITS) - 1));
+    }
+
+    // exactly halfway between two floats: round to even instead of up
+    if (product.low <= 1 && q >= FLOAT_MIN_EXPONENT_ROUND_TO_EVEN && q <= FLOAT_MAX_EXPONENT_ROUND_TO_EVEN &&
+        (mantissa & 3) == 1) {
+        if ((mantissa << shift) == product.high) {
+            mantissa &= ~(uint64)1;
+        }
+    }
+
+    mantissa += (mantissa & 1);
+    mantissa >>= 1;
+    if (mantissa >= ((uint64)2 << FLOAT_MANTISSA_BITS)) {
+        mantissa = ((uint64)1 << FLOAT_MANTISSA_BITS);
+        power2++;
+    }
+    mantissa &= ~((uint64)1 << FLOAT_MANTISSA_BITS);
+
+    if (power2 >= FLOAT_INFINITE_POWER) {
+        return (uint32)FLOAT_INFINITE_POWER << FLOAT_MANTISSA_BITS;
+    }
+    return ((uint32)power2 << FLOAT_MANTISSA_BITS) | (uint32)mantissa;
+}
+
+inline real32 parse_float_from_bits(uint32 bits) {
+    union {
+        uint32 u;
+        real32 f;
+    } convert;
+    convert.u = bits;
+    return convert.f;
+}
+
+internal_func real32 parse_decimal_to_float(const parsed_decimal* decimal, const char* token, uint64 token_length) {
+    real32 value;
+
+    // Clinger: w and 10^q are both exact floats, so one multiply/divide rounds correctly
+    const real32 exact_powers_of_ten[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    if (!decimal->truncated && decimal->w <= ((uint64)1 << 24) && decimal->q >= -10 && decimal->q <= 10) {
+        value = (real32)decimal->w;
+        if (decimal->q < 0) {
+            value /= exact_powers_of_ten[-decimal->q];
+        } else {
+            value *= exact_powers_of_ten[decimal->q];
+        }
+    } else {
+        uint32 bits = parse_compute_float(decimal->q, decimal->w);
+        if (decimal->truncated && bits != parse_compute_float(decimal->q, decimal->w + 1)) {
+            // the dropped digits matter, let the C library look at all of them.
+            // (only happens with more than 19 significant digits)
+            char copy[512];
+            uint64 copy_length = token_length < sizeof(copy) - 1 ? token_length : sizeof(copy) - 1;
+            for (uint64 n = 0; n < copy_length; n++) {
+                copy[n] = token[n];
+            }
+            copy[copy_length] = 0;
+            return strtof(copy, nullptr);
+        }
+        value = parse_float_from_bits(bits);
+    }
+
+    return decimal->negative ? -value : value;
+}
+
+uint64 string_parse_float(const char* buffer, uint64 length, real32* value) {
+    const char* end = buffer + length;
+    const char* scan = buffer;
+    while (scan < end && parse_is_space(*scan)) {
+        scan++;
+    }
+
+    parsed_decimal decimal;
+    uint64 token_length = parse_decimal(scan, end, &decimal);
+    if (token_length == 0) {
+        *value = 0.0f;
+        return 0;
+    }
+
+    *value = parse_decimal_to_float(&decimal, scan, token_length);
+    return (uint64)(scan - buffer) + token_length;
+}
+
+uint64 string_parse_int(const char* buffer, uint64 length, int32* value) {
+    const char* end = buffer + length;
+    const char* scan = buffer;
+    while (scan < end && parse_is_space(*scan)) {
+        scan++;
+    }
+
+    bool32 negative = false;
+    if (scan < end && (*scan == '-' || *scan == '+')) {
+        negative = (*scan == '-');
+        scan++;
+    }
+
+    if (scan >= end || !parse_is_digit(*scan)) {
+        *value = 0;
+        return 0;
+    }
+
+    // clamps to the int32 range instead of overflowing
+    const uint64 limit = negative ? 2147483648ull : 2147483647ull;
+    uint64 result = 0;
+    while (scan < end && parse_is_digit(*scan)) {
+        result = result*10 + (uint64)(*scan - '0');
+        if (result > limit) {
+            result = limit;
+        }
+        scan++;
+    }
+
+    *value = negative ? (int32)(0 - (int64)result) : (int32)result;
+    return (uint64)(scan - buffer);
+}
+
+// numbers are separated by whitespace and/or a comma
+inline const char* parse_skip_separators(const char* scan, const char* end) {
+    while (scan < end && (parse_is_space(*scan) || *scan == ',')) {
+        scan++;
+    }
+    return scan;
+}
+
+uint64 string_parse_floats(const char* buffer, uint64 length, real32* values, uint64 max_values, uint64* chars_consumed) {
+    const char* end = buffer + length;
+    const char* scan = buffer;
+
+    uint64 num_values = 0;
+    while (num_values < max_values) {
+        const char* next = parse_skip_separators(scan, end);
+
+        parsed_decimal decimal;
+        uint64 token_length = parse_decimal(next, end, &decimal);
+        if (token_length == 0) {
+            break;
+        }
+        values[num_values++] = parse_decimal_to_float(&decimal, next, token_length);
+        scan = next + token_length;
+    }
+
+    if (chars_consumed) {
+        *chars_consumed = (uint64)(scan - buffer);
+    }
+    return num_values;
+}
+
+uint64 string_parse_ints(const char* buffer, uint64 length, int32* values, uint64 max_values, uint64* chars_consumed) {
+    const char* end = buffer + length;
+    const char* scan = buffer;
+
+    uint64 num_values = 0;
+    while (num_values < max_values) {
+        const char* next = parse_skip_separators(scan, end);
+
+        uint64 token_length = string_parse_int(next, (uint64)(end - next), &values[num_values]);
+        if (token_length == 0) {
+            break;
+        }
+        num_values++;
+        scan = next + token_length;
+    }
+
+    if (chars_consumed) {
+        *chars_consumed = (uint64)(scan - buffer);
+    }
+    return num_values;
+}
@@ -0,0 +1,178 @@
+#include "String_Utf.h"
+
+#include "Memory/Memory_Arena.h"
+
+#include <emmintrin.h>
+
+#define UTF_REPLACEMENT_CHAR 0xFFFD
+
+// decodes one codepoint from [src, end). returns the number of bytes used (at least 1)
+internal_func uint32 utf8_decode(const uint8* src, const uint8* end, uint32* codepoint) {
+    uint8 lead = src[0];
+    uint32 length;
+    uint32 value;
+    uint32 min_value;
+    if (lead < 0x80) {
+        *codepoint = lead;
+        return 1;
+    } else if ((lead & 0xE0) == 0xC0) {
+        length = 2; value = lead & 0x1F; min_value = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3; value = lead & 0x0F; min_value = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4; value = lead & 0x07; min_value = 0x10000;
+    } else {
+        *codepoint = UTF_REPLACEMENT_CHAR;
+        return 1;
+    }
+
+    if ((uint64)(end - src) < length) {
+        *codepoint = UTF_REPLACEMENT_CHAR;
+        return 1;
+    }
+    for (uint32 n = 1; n < length; n++) {
+        if ((src[n] & 0xC0) != 0x80) {
+            // resync on the byte that broke the sequence
+            *codepoint = UTF_REPLACEMENT_CHAR;
+            return n;
+        }
+        value = (value << 6) | (src[n] & 0x3F);
+    }
+
+    // overlong, surrogate, or out of range
+    if (value < min_value || (value >= 0xD800 && value <= 0xDFFF) || value > 0x10FFFF) {
+        *codepoint = UTF_REPLACEMENT_CHAR;
+        return length;
+    }
+
+    *codepoint = value;
+    return length;
+}
+
+uint64 string_utf8_to_utf16(string_view utf8, utf16_char* dst) {
+    const uint8* src = (const uint8*)utf8.data;
+    const uint8* end = src + utf8.length;
+    utf16_char* out = dst;
+
+    while (src < end) {
+        // ASCII: widen 16 bytes at a time
+        while (end - src >= 16) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)src);
+            if (_mm_movemask_epi8(bytes) != 0) {
+                break; // something in here has the high bit set
+            }
+            __m128i zero = _mm_setzero_si128();
+            _mm_storeu_si128((__m128i*)out,       _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128((__m128i*)(out + 8), _mm_unpacklo_epi8(_mm_srli_si128(bytes, 8), zero));
+            src += 16;
+            out += 16;
+        }
+        if (src >= end) {
+            break;
+        }
+
+        uint32 codepoint;
+        src += utf8_decode(src, end, &codepoint);
+        if (codepoint >= 0x10000) {
+            // surrogate pair
+            codepoint -= 0x10000;
+            *out++ = (utf16_char)(0xD800 + (codepoint >> 10));
+            *out++ = (utf16_char)(0xDC00 + (codepoint & 0x3FF));
+        } else {
+            *out++ = (utf16_char)codepoint;
+        }
+    }
+
+    return (uint64)(out - dst);
+}
+
+uint64 string_utf16_to_utf8(const utf16_char* utf16, uint64 length, char* dst) {
+    const uint16* src = (const uint16*)utf16;
+    const uint16* end = src + length;
+    uint8* out = (uint8*)dst;
+
+    while (src < end) {
+        // ASCII: narrow 8 units at a time
+        while (end - src >= 8) {
+            __m128i units = _mm_loadu_si128((const __m128i*)src);
+            __m128i high_bits = _mm_and_si128(units, _mm_set1_epi16((int16)0xFF80));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(high_bits, _mm_setzero_si128())) != 0xFFFF) {
+                break;
+            }
+            _mm_storel_epi64((__m128i*)out, _mm_packus_epi16(units, units));
+            src += 8;
+            out += 8;
+        }
+        if (src >= end) {
+            break;
+        }
+
+        uint32 codepoint = *src++;
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+            if (src < end && *src >= 0xDC00 && *src <= 0xDFFF) {
+                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (*src++ - 0xDC00);
+            } else {
+                codepoint = UTF_REPLACEMENT_CHAR;
+            }
+        } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+            codepoint = UTF_REPLACEMENT_CHAR;
+        }
+
+        if (codepoint < 0x80) {
+            *out++ = (uint8)codepoint;
+        } else if (codepoint < 0x800) {
+            *out++ = (uint8)(0xC0 | (codepoint >> 6));
+            *out++ = (uint8)(0x80 | (codepoint & 0x3F));
+        } else if (codepoint < 0x10000) {
+            *out++ = (uint8)(0xE0 | (codepoint >> 12));
+            *out++ = (uint8)(0x80 | ((codepoint >> 6) & 0x3F));
+            *out++ = (uint8)(0x80 | (codepoint & 0x3F));
+        } else {
+            *out++ = (uint8)(0xF0 | (codepoint >> 18));
+            *out++ = (uint8)(0x80 | ((codepoint >> 12) & 0x3F));
+            *out++ = (uint8)(0x80 | ((codepoint >> 6) & 0x3F));
+            *out++ = (uint8)(0x80 | (codepoint & 0x3F));
+        }
+    }
+
+    return (uint64)(out - (uint8*)dst);
+}
+
+// gives back the tail of an allocation, if it's still the last thing on the arena
+internal_func void utf_shrink_allocation(memory_arena* arena, void* base, uint64 reserved, uint64 used) {
+    if ((uint8*)base + reserved == arena->Base + arena->Used) {
+        arena->Used -= reserved - used;
+    }
+}
+
+utf16_char* string_utf8_to_utf16(string_view utf8, memory_arena* arena, uint64* out_length) {
+    // each byte makes at most one utf16_char (a 4 byte sequence makes 2)
+    uint64 reserved = utf8.length + 1;
+
+    // arenas don't align, and the text before this was probably chars
+    if ((uint64)(arena->Base + arena->Used) & (sizeof(utf16_char) - 1)) {
+        PushSize_(arena, sizeof(utf16_char) - ((uint64)(arena->Base + arena->Used) & (sizeof(utf16_char) - 1)));
+    }
+    utf16_char* result = PushArray(arena, utf16_char, reserved);
+
+    uint64 length = string_utf8_to_utf16(utf8, result);
+    result[length] = 0;
+    utf_shrink_allocation(arena, result, reserved*sizeof(utf16_char), (length + 1)*sizeof(utf16_char));
+
+    if (out_length) {
+        *out_length = length;
+    }
+    return result;
+}
+
+string_view string_utf16_to_utf8(const utf16_char* utf16, uint64 length, memory_arena* arena) {
+    // each utf16_char makes at most 3 bytes (a surrogate pair makes 4)
+    uint64 reserved = 3*length + 1;
+    char* result = PushArray(arena, char, reserved);
+
+    uint64 result_length = string_utf16_to_utf8(utf16, length, result);
+    result[result_length] = 0;
+    utf_shrink_allocation(arena, result, reserved, result_length + 1);
+
+    return make_string_view(result, result_length);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/String.h"
+
+struct memory_arena;
+
+/*
+ * UTF-8 <-> UTF-16:
+ *   Paths are UTF-8 (char*) everywhere in the engine, and only get converted to UTF-16
+ *   right at the OS/library calls that want wide strings.
+ *
+ *   Both directions copy 16 bytes at a time while the input is ASCII (which paths almost
+ *   always are), and drop to a per-codepoint decode for anything else. Invalid input
+ *   (bad/overlong sequences, lone surrogates) is replaced with U+FFFD.
+ *
+ *   Results are pushed onto the arena, null-terminated. Worst case space is reserved first,
+ *   and whatever wasn't needed is given back if nothing else was pushed in between.
+ * */
+
+#if RH_PLATFORM_WINDOWS
+typedef wchar_t utf16_char; // so results go straight into W functions
+#else
+typedef char16_t utf16_char;
+#endif
+
+// returns the UTF-16 copy. *out_length (optional) is its length in utf16_chars, without the terminator
+RHAPI utf16_char* string_utf8_to_utf16(string_view utf8, memory_arena* arena, uint64* out_length = nullptr);
+RHAPI string_view string_utf16_to_utf8(const utf16_char* utf16, uint64 length, memory_arena* arena);
+
+// just the conversion, into a buffer that has room for the worst case:
+//   utf8 -> utf16: utf8.length utf16_chars
+//   utf16 -> utf8: 3*length chars
+// returns the number written (no terminator)
+RHAPI uint64 string_utf8_to_utf16(string_view utf8, utf16_char* dst);
+RHAPI uint64 string_utf16_to_utf8(const utf16_char* utf16, uint64 length, char* dst);
@@ -0,0 +1,216 @@
+#include "Tokenizer.h"
+
+#include "Core/Bits.h"
+#include "Memory/Memory.h"
+
+#include <tmmintrin.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define TOKENIZER_BLOCK_SIZE 64
+
+/*
+ * Nibble lookup:
+ *   class(c) = low_table[c & 0xF] & high_table[c >> 4]
+ *   Each class bit is only set for chars whose low AND high nibble both match, so the
+ *   sets have to be split up to avoid picking up extra chars:
+ *     bit 0: ' '                 (high 0x2, low 0x0)
+ *     bit 1: '\t' '\v' '\f' '\r' (high 0x0, low 0x9 0xB 0xC 0xD)
+ *     bit 2: '\n'                (high 0x0, low 0xA)
+ * */
+#define CLASS_SPACE   0x01
+#define CLASS_TAB_CR  0x02
+#define CLASS_NEWLINE 0x04
+
+#define TOKENIZER_LOW_TABLE                                                            \
+    CLASS_SPACE, 0, 0, 0, 0, 0, 0, 0,                                                  \
+    0, CLASS_TAB_CR, CLASS_NEWLINE, CLASS_TAB_CR, CLASS_TAB_CR, CLASS_TAB_CR, 0, 0
+#define TOKENIZER_HIGH_TABLE                                                           \
+    CLASS_TAB_CR | CLASS_NEWLINE, 0, CLASS_SPACE, 0, 0, 0, 0, 0,                       \
+    0, 0, 0, 0, 0, 0, 0, 0
+
+#if defined(__AVX2__)
+#define TOKENIZER_TARGET
+#elif defined(__GNUC__) || defined(__clang__)
+// MSVC lets any intrinsic through, gcc/clang need to be told
+#define TOKENIZER_TARGET __attribute__((target("ssse3")))
+#else
+#define TOKENIZER_TARGET
+#endif
+
+#if defined(__AVX2__)
+// classifies 32 bytes, and returns the space (incl. newline) and newline bits
+TOKENIZER_TARGET inline void tokenizer_classify(const char* bytes, uint32* space_bits, uint32* newline_bits) {
+    const __m256i low_table  = _mm256_setr_epi8(TOKENIZER_LOW_TABLE, TOKENIZER_LOW_TABLE);
+    const __m256i high_table = _mm256_setr_epi8(TOKENIZER_HIGH_TABLE, TOKENIZER_HIGH_TABLE);
+    const __m256i nibble     = _mm256_set1_epi8(0x0F);
+
+    __m256i input = _mm256_loadu_si256((const __m256i*)bytes);
+    __m256i low   = _mm256_shuffle_epi8(low_table, _mm256_and_si256(input, nibble));
+    __m256i high  = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    __m256i classes = _mm256_and_si256(low, high);
+
+    __m256i zero = _mm256_setzero_si256();
+    *space_bits   = ~(uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(classes, zero));
+    *newline_bits = ~(uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(classes, _mm256_set1_epi8(CLASS_NEWLINE)), zero));
+}
+#define TOKENIZER_SIMD_WIDTH 32
+#else
+// classifies 16 bytes, and returns the space (incl. newline) and newline bits
+TOKENIZER_TARGET inline void tokenizer_classify(const char* bytes, uint32* space_bits, uint32* newline_bits) {
+    const __m128i low_table  = _mm_setr_epi8(TOKENIZER_LOW_TABLE);
+    const __m128i high_table = _mm_setr_epi8(TOKENIZER_HIGH_TABLE);
+    const __m128i nibble     = _mm_set1_epi8(0x0F);
+
+    __m128i input = _mm_loadu_si128((const __m128i*)bytes);
+    __m128i low   = _mm_shuffle_epi8(low_table, _mm_and_si128(input, nibble));
+    __m128i high  = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    __m128i classes = _mm_and_si128(low, high);
+
+    __m128i zero = _mm_setzero_si128();
+    *space_bits   = ~(uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(classes, zero)) & 0xFFFF;
+    *newline_bits = ~(uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(classes, _mm_set1_epi8(CLASS_NEWLINE)), zero)) & 0xFFFF;
+}
+#define TOKENIZER_SIMD_WIDTH 16
+#endif
+
+internal_func void tokenizer_load_block(text_tokenizer* tokenizer, uint64 block_start) {
+    const char* bytes = tokenizer->data + block_start;
+
+    // the last block gets copied out and padded with spaces, so we never read past
+    // the end of the mapping (which could be the end of a page)
+    char tail[TOKENIZER_BLOCK_SIZE];
+    uint64 remaining = tokenizer->length - block_start;
+    if (remaining < TOKENIZER_BLOCK_SIZE) {
+        memory_set(tail, ' ', TOKENIZER_BLOCK_SIZE);
+        memory_copy(tail, bytes, remaining);
+        bytes = tail;
+    }
+
+    uint64 space_mask = 0;
+    uint64 newline_mask = 0;
+    for (uint32 n = 0; n < TOKENIZER_BLOCK_SIZE; n += TOKENIZER_SIMD_WIDTH) {
+        uint32 space_bits, newline_bits;
+        tokenizer_classify(bytes + n, &space_bits, &newline_bits);
+        space_mask   |= (uint64)space_bits << n;
+        newline_mask |= (uint64)newline_bits << n;
+    }
+
+    tokenizer->block_start  = block_start;
+    tokenizer->space_mask   = space_mask;
+    tokenizer->newline_mask = newline_mask;
+}
+
+enum tokenizer_search {
+    FIND_TOKEN,             // anything that isn't whitespace
+    FIND_TOKEN_OR_NEWLINE,
+    FIND_SPACE,             // end of a token
+    FIND_NEWLINE,
+};
+
+// first position >= pos matching the search, or length
+inline uint64 tokenizer_find(text_tokenizer* tokenizer, uint64 pos, tokenizer_search search) {
+    while (pos < tokenizer->length) {
+        uint64 block_start = pos & ~(uint64)(TOKENIZER_BLOCK_SIZE - 1);
+        if (block_start != tokenizer->block_start) {
+            tokenizer_load_block(tokenizer, block_start);
+        }
+
+        uint64 mask;
+        switch (search) {
+            case FIND_TOKEN:            mask = ~tokenizer->space_mask; break;
+            case FIND_TOKEN_OR_NEWLINE: mask = ~tokenizer->space_mask | tokenizer->newline_mask; break;
+            case FIND_SPACE:            mask = tokenizer->space_mask; break;
+            default:                    mask = tokenizer->newline_mask; break;
+        }
+        mask &= ~(uint64)0 << (pos - block_start);
+
+        if (mask) {
+            uint64 found = block_start + bit_scan_forward64(mask);
+            return found < tokenizer->length ? found : tokenizer->length;
+        }
+        pos = block_start + TOKENIZER_BLOCK_SIZE;
+    }
+
+    return tokenizer->length;
+}
+
+void tokenizer_init(text_tokenizer* tokenizer, string_view text) {
+    tokenizer->data   = text.data;
+    tokenizer->length = text.length;
+    tokenizer->pos    = 0;
+
+    // force the first block to load
+    tokenizer->block_start  = ~(uint64)0;
+    tokenizer->space_mask   = 0;
+    tokenizer->newline_mask = 0;
+}
+
+bool32 tokenizer_at_end(text_tokenizer* tokenizer) {
+    return tokenizer->pos >= tokenizer->length;
+}
+
+bool32 tokenizer_next_token(text_tokenizer* tokenizer, string_view* token) {
+    uint64 start = tokenizer_find(tokenizer, tokenizer->pos, FIND_TOKEN);
+    if (start >= tokenizer->length) {
+        tokenizer->pos = tokenizer->length;
+        return false;
+    }
+
+    uint64 end = tokenizer_find(tokenizer, start, FIND_SPACE);
+    *token = make_string_view(tokenizer->data + start, end - start);
+    tokenizer->pos = end;
+    return true;
+}
+
+bool32 tokenizer_next_token_on_line(text_tokenizer* tokenizer, string_view* token) {
+    uint64 start = tokenizer_find(tokenizer, tokenizer->pos, FIND_TOKEN_OR_NEWLINE);
+    if (start >= tokenizer->length || tokenizer->data[start] == '\n') {
+        // stop in front of the newline, tokenizer_skip_line/next_line moves past it
+        tokenizer->pos = start;
+        return false;
+    }
+
+    uint64 end = tokenizer_find(tokenizer, start, FIND_SPACE);
+    *token = make_string_view(tokenizer->data + start, end - start);
+    tokenizer->pos = end;
+    return true;
+}
+
+bool32 tokenizer_next_line(text_tokenizer* tokenizer, string_view* line) {
+    if (tokenizer->pos >= tokenizer->length) {
+        return false;
+    }
+
+    uint64 start = tokenizer->pos;
+    uint64 end = tokenizer_find(tokenizer, start, FIND_NEWLINE);
+    tokenizer->pos = (end < tokenizer->length) ? end + 1 : end;
+
+    if (end > start && tokenizer->data[end - 1] == '\r') {
+        end--;
+    }
+    *line = make_string_view(tokenizer->data + start, end - start);
+    return true;
+}
+
+void tokenizer_skip_line(text_tokenizer* tokenizer) {
+    uint64 end = tokenizer_find(tokenizer, tokenizer->pos, FIND_NEWLINE);
+    tokenizer->pos = (end < tokenizer->length) ? end + 1 : end;
+}
+
+bool32 tokenizer_next_float(text_tokenizer* tokenizer, real32* value) {
+    string_view token;
+    if (!tokenizer_next_token_on_line(tokenizer, &token)) {
+        return false;
+    }
+    return string_parse_float(token, value) == token.length;
+}
+
+bool32 tokenizer_next_int(text_tokenizer* tokenizer, int32* value) {
+    string_view token;
+    if (!tokenizer_next_token_on_line(tokenizer, &token)) {
+        return false;
+    }
+    return string_parse_int(token, value) == token.length;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Defines.h"
+#include "Core/String.h"
+
+/*
+ * Text tokenizer:
+ *   Walks a block of text (usually a whole file in memory) and hands out string_views into it,
+ *   so nothing is ever copied. Text is classified 64 bytes at a time with a SIMD nibble
+ *   lookup table (pshufb), giving one bitmask of whitespace and one of newlines per block.
+ *   Finding the start/end of a token is then a bit scan on those masks.
+ *
+ *   Tokens are runs of anything that isn't whitespace (' ', '\t', '\r', '\v', '\f') or '\n'.
+ *
+ *   e.g. an .obj file:
+ *     text_tokenizer tokenizer;
+ *     tokenizer_init(&tokenizer, make_string_view((char*)file.data, file.num_bytes));
+ *     string_view token;
+ *     while (tokenizer_next_token(&tokenizer, &token)) {
+ *         if (string_equals(token, make_string_view("v", 1))) {
+ *             tokenizer_next_float(&tokenizer, &x); ...
+ *         }
+ *         tokenizer_skip_line(&tokenizer);
+ *     }
+ *
+ *   Needs SSSE3 (AVX2 if the build enables it).
+ * */
+
+struct text_tokenizer {
+    const char* data;
+    uint64 length;
+    uint64 pos;          // next char to look at
+
+    // classification of the 64-byte block at block_start
+    uint64 block_start;
+    uint64 space_mask;   // whitespace, including newlines
+    uint64 newline_mask;
+};
+
+RHAPI void tokenizer_init(text_tokenizer* tokenizer, string_view text);
+RHAPI bool32 tokenizer_at_end(text_tokenizer* tokenizer);
+
+// next token, skipping any whitespace and newlines in front of it
+RHAPI bool32 tokenizer_next_token(text_tokenizer* tokenizer, string_view* token);
+// next token on the current line. returns false (without moving to the next line) at the end of the line
+RHAPI bool32 tokenizer_next_token_on_line(text_tokenizer* tokenizer, string_view* token);
+// the rest of the current line, without the line ending. moves to the start of the next line
+RHAPI bool32 tokenizer_next_line(text_tokenizer* tokenizer, string_view* line);
+RHAPI void tokenizer_skip_line(text_tokenizer* tokenizer);
+
+// next token on the current line, parsed as a number. false if there isn't one,
+// or it isn't a number (the token is still consumed)
+RHAPI bool32 tokenizer_next_float(text_tokenizer* tokenizer, real32* value);
+RHAPI bool32 tokenizer_next_int(text_tokenizer* tokenizer, int32* value);
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Defines.h"
+
+struct AppConfig {
+    const char* application_name;
+    int32 start_x;
+    int32 start_y;
+    int32 start_width;
+    int32 start_height;
+
+    uint64 requested_memory;
+};
+
+/*
+* Platform Layer:
+*   provides services to higher layers
+* 
+* exported functions:
+*   startup()
+*   shutdown()
+*   process_messages()
+*   platform_alloc() <= returns zeroed memory :)
+*   platform_free()
+*   write to console
+*   get_time()
+*   sleep()
+* 
+* File I/O
+* */
+
+void platform_init_logging(bool32 create_console);
+RHAPI bool32 platform_setup_paths();
+bool32 platform_startup(AppConfig* config);
+RHAPI void platform_shutdown();
+bool32 platform_process_messages();
+void* platform_alloc(uint64 size, uint64 base_address);
+void platform_free(void* memory);
+bool32 platform_assert_message(const char* fmt, ...);
+void platform_console_write_error(const char* Message, uint8 Color);
+void platform_console_write(const char* Message, uint8 Color);
+void platform_console_set_title(const char* title);
+int64 platform_get_wall_clock();
+real64 platform_get_seconds_elapsed(int64 start, int64 end);
+// wall clock ticks per second
+RHAPI int64 platform_get_wall_clock_frequency();
+RHAPI void platform_sleep(uint64 ms);
+// sleeps until platform_get_wall_clock() reaches wall_clock, on the finest timer the os has.
+// can wake up late (tens of microseconds to a millisecond or so), so spin the last bit if it matters
+RHAPI void platform_sleep_until(int64 wall_clock);
+// tells the cpu this is a spin-wait loop
+RHAPI void platform_cpu_pause();
+void platform_update_mouse();
+
+// threading
+typedef uint32 (*platform_thread_func)(void* data);
+RHAPI void*  platform_create_thread(platform_thread_func func, void* data);
+RHAPI void   platform_join_thread(void* thread);
+RHAPI void*  platform_create_semaphore(uint32 initial_count, uint32 max_count);
+RHAPI void   platform_destroy_semaphore(void* semaphore);
+RHAPI void   platform_signal_semaphore(void* semaphore);
+// returns true if signaled, false on timeout
+RHAPI bool32 platform_wait_semaphore(void* semaphore, uint32 timeout_ms);
+// cores this process can run on. hyperthreads of the same core count once for physical
+RHAPI uint32 platform_get_num_physical_cores();
+RHAPI uint32 platform_get_num_logical_cores();
+
+// rendering stuff
+void platform_swap_buffers();
+
+// file i/o
+struct file_handle {
+    uint64 num_bytes;
+    uint8* data;
+};
+size_t platform_get_full_resource_path(char* buffer, size_t buffer_length, const char* resource_path);
+RHAPI file_handle platform_read_entire_file(const char* full_path);
+RHAPI bool32 platform_write_entire_file(const char* full_path, const void* data, uint64 num_bytes);
+RHAPI void platform_free_file_data(file_handle* handle);
+
+// a file mapped into memory for writing.
+// these don't log anything, so the logger can write through them.
+struct mapped_file {
+    uint8* data;
+    uint64 num_bytes;
+    void* file;
+    void* mapping;
+};
+// creates (or overwrites) full_path, sized to num_bytes, and maps all of it
+RHAPI bool32 platform_create_mapped_file(const char* full_path, uint64 num_bytes, mapped_file* file);
+// starts writing the range back to disk, doesn't wait for the disk
+RHAPI void platform_flush_mapped_file(mapped_file* file, uint64 offset, uint64 num_bytes);
+// unmaps and closes the file, truncating it to final_size
+RHAPI void platform_close_mapped_file(mapped_file* file, uint64 final_size);
+// hints for how a read-only mapping is going to be used
+enum platform_map_flags {
+    PLATFORM_MAP_DEFAULT    = 0,
+    PLATFORM_MAP_SEQUENTIAL = 0x1, // read front to back: read far ahead, and pages behind can be dropped
+    PLATFORM_MAP_RANDOM     = 0x2, // jumps around: don't read ahead of each fault
+    PLATFORM_MAP_PREFAULT   = 0x4, // read it all in up front, so touching it later never waits on the disk
+};
+// maps an existing file read-only. an empty file maps to data == nullptr, num_bytes == 0
+RHAPI bool32 platform_map_file(const char* full_path, mapped_file* file, uint32 flags = PLATFORM_MAP_DEFAULT);
+// changes the hint for part of a mapped file. PLATFORM_MAP_PREFAULT starts reading the range in, without waiting for it
+RHAPI void platform_advise_mapped_file(mapped_file* file, uint64 offset, uint64 num_bytes, uint32 flags);
+RHAPI void platform_unmap_file(mapped_file* file);
+
+// asynchronous file reads.
+// reads are queued with platform_async_read, handed to the os in one go by platform_async_submit,
+// and come back through platform_async_poll/wait. uses io_uring on linux, and a pool of threads
+// doing blocking reads otherwise. everything but platform_read_file_at has to be called from
+// the same thread.
+enum async_read_status {
+    ASYNC_READ_PENDING = 0,
+    ASYNC_READ_DONE,
+    ASYNC_READ_FAILED,
+};
+struct async_read {
+    // filled in by the caller
+    void*  file; // from platform_open_async_file
+    uint64 offset;
+    void*  buffer;
+    uint64 num_bytes;
+    void*  user_data;
+
+    // filled in by the platform. only touch these once the read has come back
+    uint32 status; // async_read_status
+    uint64 bytes_read; // less than num_bytes only if the file ended first
+};
+// max_in_flight is how many reads can be queued or running at once
+RHAPI bool32 platform_async_io_init(uint32 max_in_flight);
+// waits for whatever is still in flight
+RHAPI void   platform_async_io_shutdown();
+// returns nullptr if the file can't be opened. num_bytes is optional
+RHAPI void*  platform_open_async_file(const char* full_path, uint64* num_bytes);
+RHAPI void   platform_close_async_file(void* file);
+// queues a read. the request (and its buffer) must stay put until it comes back.
+// returns false if max_in_flight reads are already queued or running
+RHAPI bool32 platform_async_read(async_read* request);
+// starts all reads queued since the last submit
+RHAPI void   platform_async_submit();
+RHAPI uint32 platform_async_num_in_flight();
+// fills completed[] with up to max_completed reads that have come back, and returns how many.
+// poll doesn't wait, wait blocks until at least one comes back, nothing is in flight, or the timeout.
+// both submit anything still queued first
+RHAPI uint32 platform_async_poll(async_read** completed, uint32 max_completed);
+RHAPI uint32 platform_async_wait(async_read** completed, uint32 max_completed, uint32 timeout_ms);
+// blocking read at an offset, from any thread. bytes_read is less than num_bytes only at the end of the file
+RHAPI bool32 platform_read_file_at(void* file, uint64 offset, void* buffer, uint64 num_bytes, uint64* bytes_read);
+
+struct file_info {
+    uint64 file_attributes;
+    uint64 creation_time;
+    uint64 last_access_time;
+    uint64 last_write_time;
+    uint64 file_size;
+};
+RHAPI size_t platform_get_full_library_path(char* buffer, size_t buffer_length, const char* library_path);
+RHAPI bool32 platform_get_file_attributes(const char* full_path, file_info* info);
+RHAPI bool32 platform_copy_file(const char* src_path, const char* dst_path);
+// replaces dst_path if it exists
+RHAPI bool32 platform_move_file(const char* src_path, const char* dst_path);
+
+RHAPI void* platform_load_shared_library(const char* lib_path);
+RHAPI void* platform_get_func_from_lib(void* shared_lib, const char* func_name);
+RHAPI void  platform_unload_shared_library(void* shared_lib);
+RHAPI void  platform_filetime_to_systime(uint64 file_time, char* buffer, uint64 buf_size);
+
+// this is bad and dumb :)
+#if RH_PLATFORM_WINDOWS
+void* platform_get_window_handle();
+#elif RH_PLATFORM_LINUX
+void* platform_get_raw_handle();
+uint32 platform_get_window_id();
+#endif
\ No newline at end of file
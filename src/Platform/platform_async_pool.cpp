@@ -0,0 +1,264 @@
+#include "platform_async_pool.h"
+
+#include "Core/Logger.h"
+#include "Core/Asserts.h"
+
+#include <atomic>
+#include <new>
+
+#define ASYNC_POOL_IDLE_WAIT_MS 100
+#define ASYNC_POOL_SHUTDOWN_BATCH 16
+
+// bounded lock-free MPMC queue, sequence number per cell
+struct async_pool_cell {
+    std::atomic<uint32> sequence;
+    async_read* request;
+};
+struct async_pool_queue {
+    async_pool_cell* cells;
+    uint32 mask;
+
+    // keep producer/consumer positions on separate cache lines
+    uint8 pad0[64];
+    std::atomic<uint32> enqueue_pos;
+    uint8 pad1[64];
+    std::atomic<uint32> dequeue_pos;
+    uint8 pad2[64];
+};
+
+struct async_pool {
+    async_pool_queue requests;    // calling thread -> workers
+    async_pool_queue completions; // workers -> calling thread
+
+    // only touched by the calling thread
+    uint32 max_in_flight;
+    uint32 num_in_flight;
+    uint32 num_queued; // since the last submit
+
+    std::atomic<uint32> running;
+    void* work;  // wakes up workers
+    void* done;  // wakes up the calling thread when something completes
+    uint32 num_threads;
+    void* threads[ASYNC_POOL_MAX_THREADS];
+};
+global_variable async_pool* global_async_pool;
+
+internal_func void async_pool_queue_init(async_pool_queue* queue, async_pool_cell* cells, uint32 num_cells) {
+    queue->cells = cells;
+    queue->mask = num_cells - 1;
+    for (uint32 n = 0; n < num_cells; n++) {
+        async_pool_cell* cell = new (&queue->cells[n]) async_pool_cell;
+        cell->sequence.store(n, std::memory_order_relaxed);
+    }
+    queue->enqueue_pos.store(0);
+    queue->dequeue_pos.store(0);
+}
+
+internal_func bool32 async_pool_push(async_pool_queue* queue, async_read* request) {
+    async_pool_cell* cell;
+    uint32 pos = queue->enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        int32 diff = (int32)(cell->sequence.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (queue->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // full
+        } else {
+            pos = queue->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->request = request;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+internal_func bool32 async_pool_pop(async_pool_queue* queue, async_read** request) {
+    async_pool_cell* cell;
+    uint32 pos = queue->dequeue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        cell = &queue->cells[pos & queue->mask];
+        int32 diff = (int32)(cell->sequence.load(std::memory_order_acquire) - (pos + 1));
+        if (diff == 0) {
+            if (queue->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // empty
+        } else {
+            pos = queue->dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    *request = cell->request;
+    // hand the cell back to producers
+    cell->sequence.store(pos + queue->mask + 1, std::memory_order_release);
+    return true;
+}
+
+internal_func uint32 async_pool_worker(void* data) {
+    async_pool* pool = (async_pool*)data;
+
+    for (;;) {
+        async_read* request;
+        while (async_pool_pop(&pool->requests, &request)) {
+            uint64 bytes_read = 0;
+            bool32 result = platform_read_file_at(request->file, request->offset, request->buffer, request->num_bytes, &bytes_read);
+            request->bytes_read = bytes_read;
+            request->status = result ? ASYNC_READ_DONE : ASYNC_READ_FAILED;
+
+            // can't fail, there are never more than max_in_flight requests around
+            async_pool_push(&pool->completions, request);
+            platform_signal_semaphore(pool->done);
+        }
+
+        if (!pool->running.load()) {
+            break;
+        }
+        platform_wait_semaphore(pool->work, ASYNC_POOL_IDLE_WAIT_MS);
+    }
+
+    return 0;
+}
+
+bool32 async_pool_init(uint32 max_in_flight, uint32 num_threads) {
+    AssertMsg(!global_async_pool, "The async read pool is already running!");
+    if (num_threads > ASYNC_POOL_MAX_THREADS) num_threads = ASYNC_POOL_MAX_THREADS;
+    if (num_threads > max_in_flight)          num_threads = max_in_flight;
+    if (num_threads == 0)                     num_threads = 1;
+
+    // round up to a power of 2 so cells can be found with a mask
+    uint32 num_cells = 2;
+    while (num_cells < max_in_flight) {
+        num_cells <<= 1;
+    }
+
+    void* memory = platform_alloc(sizeof(async_pool) + 2*num_cells*sizeof(async_pool_cell), 0);
+    if (!memory) {
+        return false;
+    }
+
+    // construct the atomics in place, the memory comes back zeroed but unconstructed
+    async_pool* pool = new (memory) async_pool;
+    async_pool_cell* cells = (async_pool_cell*)(pool + 1);
+    async_pool_queue_init(&pool->requests,    cells,             num_cells);
+    async_pool_queue_init(&pool->completions, cells + num_cells, num_cells);
+    pool->max_in_flight = max_in_flight;
+
+    // max counts just coalesce wakeups, workers and the waiter drain their queue before sleeping again
+    pool->work = platform_create_semaphore(0, num_threads);
+    pool->done = platform_create_semaphore(0, 1);
+    if (!pool->work || !pool->done) {
+        if (pool->work) platform_destroy_semaphore(pool->work);
+        if (pool->done) platform_destroy_semaphore(pool->done);
+        platform_free(pool);
+        return false;
+    }
+
+    pool->running.store(1);
+    for (uint32 n = 0; n < num_threads; n++) {
+        pool->threads[n] = platform_create_thread(async_pool_worker, pool);
+        if (!pool->threads[n]) {
+            break;
+        }
+        pool->num_threads++;
+    }
+    if (pool->num_threads == 0) {
+        platform_destroy_semaphore(pool->work);
+        platform_destroy_semaphore(pool->done);
+        platform_free(pool);
+        return false;
+    }
+
+    global_async_pool = pool;
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Async reads go through %u threads, %u reads in flight.", pool->num_threads, max_in_flight);
+    return true;
+}
+
+void async_pool_shutdown() {
+    async_pool* pool = global_async_pool;
+    if (!pool) {
+        return;
+    }
+
+    // requests point into the caller's memory, don't leave any running
+    async_read* completed[ASYNC_POOL_SHUTDOWN_BATCH];
+    while (pool->num_in_flight) {
+        async_pool_wait(completed, ASYNC_POOL_SHUTDOWN_BATCH, ASYNC_POOL_IDLE_WAIT_MS);
+    }
+
+    pool->running.store(0);
+    for (uint32 n = 0; n < pool->num_threads; n++) {
+        platform_signal_semaphore(pool->work);
+    }
+    for (uint32 n = 0; n < pool->num_threads; n++) {
+        platform_join_thread(pool->threads[n]);
+    }
+
+    platform_destroy_semaphore(pool->work);
+    platform_destroy_semaphore(pool->done);
+    platform_free(pool);
+    global_async_pool = nullptr;
+}
+
+bool32 async_pool_read(async_read* request) {
+    async_pool* pool = global_async_pool;
+    AssertMsg(pool, "Async reads haven't been initialized!");
+    if (pool->num_in_flight == pool->max_in_flight) {
+        return false;
+    }
+
+    request->status = ASYNC_READ_PENDING;
+    request->bytes_read = 0;
+    async_pool_push(&pool->requests, request);
+    pool->num_in_flight++;
+    pool->num_queued++;
+    return true;
+}
+
+void async_pool_submit() {
+    async_pool* pool = global_async_pool;
+    if (!pool || pool->num_queued == 0) {
+        return;
+    }
+
+    // workers keep popping until the queue is empty, so one wakeup per idle worker is enough
+    uint32 num_wakeups = (pool->num_queued < pool->num_threads) ? pool->num_queued : pool->num_threads;
+    for (uint32 n = 0; n < num_wakeups; n++) {
+        platform_signal_semaphore(pool->work);
+    }
+    pool->num_queued = 0;
+}
+
+uint32 async_pool_num_in_flight() {
+    return global_async_pool ? global_async_pool->num_in_flight : 0;
+}
+
+uint32 async_pool_wait(async_read** completed, uint32 max_completed, uint32 timeout_ms) {
+    async_pool* pool = global_async_pool;
+    if (!pool) {
+        return 0;
+    }
+    async_pool_submit();
+
+    int64 start = platform_get_wall_clock();
+    for (;;) {
+        uint32 num_completed = 0;
+        while (num_completed < max_completed && async_pool_pop(&pool->completions, &completed[num_completed])) {
+            num_completed++;
+        }
+        pool->num_in_flight -= num_completed;
+        if (num_completed > 0 || pool->num_in_flight == 0) {
+            return num_completed;
+        }
+
+        real64 elapsed_ms = 1000.0 * platform_get_seconds_elapsed(start, platform_get_wall_clock());
+        if (elapsed_ms >= (real64)timeout_ms) {
+            return 0;
+        }
+        platform_wait_semaphore(pool->done, timeout_ms - (uint32)elapsed_ms);
+    }
+}
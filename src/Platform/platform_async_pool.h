@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Platform.h"
+
+/*
+ * Thread pool backend for the async file reads in Platform.h:
+ *   Queued reads go into a bounded lock-free queue, and a few worker threads pull them
+ *   out and do blocking platform_read_file_at calls, so there's always a handful of reads
+ *   sitting at the disk. Finished reads go into a second queue the calling thread drains.
+ *
+ *   Used on windows, and on linux when io_uring isn't available.
+ *   Only the platform layers call these.
+ * */
+
+#define ASYNC_POOL_MAX_THREADS 8
+
+bool32 async_pool_init(uint32 max_in_flight, uint32 num_threads);
+void   async_pool_shutdown();
+bool32 async_pool_read(async_read* request);
+void   async_pool_submit();
+uint32 async_pool_num_in_flight();
+uint32 async_pool_wait(async_read** completed, uint32 max_completed, uint32 timeout_ms);
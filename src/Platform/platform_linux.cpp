@@ -0,0 +1,1175 @@
+#include "Defines.h"
+
+#ifdef RH_PLATFORM_LINUX
+
+// <fcntl.h> has its own 'struct file_handle' (for name_to_handle_at) when _GNU_SOURCE is
+// defined, which g++ always does. Rename it while the system headers are included.
+#define file_handle linux_file_handle
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#undef file_handle
+
+#include "Platform.h"
+#include "platform_async_pool.h"
+
+#include "Core/Logger.h"
+#include "Core/Asserts.h"
+#include "Memory/Memory.h"
+#include "Core/String.h"
+
+/*
+ * Linux platform layer:
+ *   Headless for now. There's no window, so there are no window or input messages, and
+ *   platform_process_messages() only reports whether the process was asked to stop
+ *   (SIGINT/SIGTERM). Input can still come from an input recording (Core/Input_Record.h),
+ *   and the null renderer stands in for the DX12 one, so the whole engine loop runs.
+ * */
+
+#define LINUX_STATE_FILE_NAME_COUNT 4096 // PATH_MAX
+
+// platform_linux.cpp manages this struct, no one else needs to access it
+struct PlatformState {
+    char exe_path[LINUX_STATE_FILE_NAME_COUNT];
+    uint64 exe_path_len;
+
+    char resource_path_prefix[LINUX_STATE_FILE_NAME_COUNT];
+    uint64 resource_path_prefix_length;
+
+    char library_path_prefix[LINUX_STATE_FILE_NAME_COUNT];
+    uint64 library_path_prefix_length;
+
+    uint64 page_size;
+
+    bool32 console_colors; // only when writing to a terminal
+};
+global_variable PlatformState global_linux_state;
+
+// set from the signal handler
+global_variable volatile sig_atomic_t global_quit_requested;
+
+internal_func void linux_on_quit_signal(int signal_number) {
+    global_quit_requested = 1;
+}
+
+internal_func uint64 linux_page_size() {
+    if (global_linux_state.page_size == 0) {
+        long page_size = sysconf(_SC_PAGESIZE);
+        global_linux_state.page_size = (page_size > 0) ? (uint64)page_size : 4096;
+    }
+    return global_linux_state.page_size;
+}
+
+// copies src after prefix into dest, returns the new length
+internal_func size_t linux_cat_path(char* dest, size_t dest_length, const char* prefix, size_t prefix_length, const char* src) {
+    size_t src_length = strlen(src);
+    AssertMsg(prefix_length + src_length < dest_length, "Path is too long!");
+
+    memcpy(dest, prefix, prefix_length);
+    memcpy(dest + prefix_length, src, src_length);
+    dest[prefix_length + src_length] = 0;
+    return prefix_length + src_length;
+}
+
+bool32 platform_setup_paths() {
+    // find out current working directory -> this changes depending on
+    // how the game is launched! Same rigamarole as on windows, so it
+    // ends up the same regardless.
+    char cwd[LINUX_STATE_FILE_NAME_COUNT];
+    if (!getcwd(cwd, sizeof(cwd))) return false;
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Current Working Directory: [%s]", cwd);
+
+    // 1.  find the executable filename, and strip everything after the last /
+    ssize_t length = readlink("/proc/self/exe", global_linux_state.exe_path, LINUX_STATE_FILE_NAME_COUNT - 1);
+    if (length <= 0) return false;
+    global_linux_state.exe_path[length] = 0;
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "EXE filename: [%s]", global_linux_state.exe_path);
+    global_linux_state.exe_path_len = 1+string_find_last(global_linux_state.exe_path, global_linux_state.exe_path+length, '/'); // add 1 to get the trailing slash
+    global_linux_state.exe_path[global_linux_state.exe_path_len] = 0;
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "EXE path:     [%s]", global_linux_state.exe_path);
+
+    // 2.  cd into the exe path, so we start next to the executable always
+    if (chdir(global_linux_state.exe_path) != 0) return false;
+    if (!getcwd(cwd, sizeof(cwd))) return false;
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Current Working Directory: [%s]", cwd);
+
+    // 2.5 see platform_win32.cpp: in development the executable is in /bin
+    struct stat data_info;
+    if (stat("./Data/", &data_info) == 0 && S_ISDIR(data_info.st_mode)) {
+        // we are in the run_tree directory
+    } else {
+        #if RH_INTERNAL
+        // we are in the bin directory
+        if (chdir("../Game/run_tree/") != 0) return false;
+        if (!getcwd(cwd, sizeof(cwd))) return false;
+        RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Current Working Directory: [%s]", cwd);
+        #endif
+    }
+
+    global_linux_state.resource_path_prefix_length = string_copy(global_linux_state.resource_path_prefix,
+                                                                 LINUX_STATE_FILE_NAME_COUNT, (char*)"./") - 1;
+
+    global_linux_state.library_path_prefix_length = string_copy(global_linux_state.library_path_prefix,
+                                                                LINUX_STATE_FILE_NAME_COUNT,
+                                                                global_linux_state.exe_path) - 1;
+
+    return true;
+}
+
+void platform_init_logging(bool32 create_console) {
+    // there is no console to create, only color the output if it goes to a terminal
+    global_linux_state.console_colors = isatty(STDOUT_FILENO) && isatty(STDERR_FILENO);
+}
+
+bool32 platform_startup(AppConfig* config) {
+    linux_page_size();
+
+    struct sigaction action = {};
+    action.sa_handler = linux_on_quit_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT,  &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Running '%s' headless, no window is created.", config->application_name);
+    return true;
+}
+
+void platform_shutdown() {
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Shutting down the platform layer.");
+}
+
+bool32 platform_process_messages() {
+    // no window, so no messages. just check if someone hit Ctrl+C
+    return !global_quit_requested;
+}
+
+// allocated memory in page-size from the os.
+// don't use this function for small dynamic allocations!!
+// the first page holds the size (munmap needs it), the memory starts after it
+void* platform_alloc(uint64 size, uint64 base_address) {
+    uint64 page_size = linux_page_size();
+    uint64 total_size = size + page_size;
+
+    void* address_hint = base_address ? (void*)(base_address - page_size) : nullptr;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #ifdef MAP_FIXED_NOREPLACE
+    if (base_address) {
+        flags |= MAP_FIXED_NOREPLACE;
+    }
+    #endif
+
+    void* memory = mmap(address_hint, (size_t)total_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    if (base_address && memory != address_hint) {
+        // like VirtualAlloc, fail instead of handing out a different address
+        munmap(memory, (size_t)total_size);
+        return nullptr;
+    }
+
+    *(uint64*)memory = total_size;
+    return (uint8*)memory + page_size;
+}
+
+void platform_free(void* memory) {
+    if (!memory) {
+        return;
+    }
+    uint8* base = (uint8*)memory - linux_page_size();
+    munmap(base, (size_t)(*(uint64*)base));
+}
+
+bool32 platform_assert_message(const char* fmt, ...) {
+    char MsgBuffer[1024];
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(MsgBuffer, sizeof(MsgBuffer), fmt, args);
+    va_end(args);
+
+    // nobody to ask, so always break
+    fprintf(stderr, "Assertion Failed!\n%s\n", MsgBuffer);
+    fflush(stderr);
+    return true;
+}
+
+// read()/write() can stop short, and can be interrupted
+internal_func bool32 linux_read_all(int fd, uint8* buffer, uint64 num_bytes) {
+    while (num_bytes > 0) {
+        ssize_t result = read(fd, buffer, (size_t)num_bytes);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (result == 0) {
+            return false; // file got shorter
+        }
+        buffer += result;
+        num_bytes -= (uint64)result;
+    }
+    return true;
+}
+internal_func bool32 linux_write_all(int fd, const uint8* buffer, uint64 num_bytes) {
+    while (num_bytes > 0) {
+        ssize_t result = write(fd, buffer, (size_t)num_bytes);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        buffer += result;
+        num_bytes -= (uint64)result;
+    }
+    return true;
+}
+
+// FATAL,ERROR,WARN,INFO,DEBUG,TRACE. same colors as the windows console
+global_variable const char* console_level_colors[6] = {"\x1b[97;41m", "\x1b[31m", "\x1b[33m", "\x1b[32m", "\x1b[34m", "\x1b[90m"};
+internal_func void linux_console_write(int fd, const char* Message, uint8 Color) {
+    size_t length = strlen(Message);
+
+    // one write, so lines from different threads don't get their colors mixed up
+    char buffer[4096];
+    if (global_linux_state.console_colors && Color < 6) {
+        int written = snprintf(buffer, sizeof(buffer), "%s%s\x1b[0m", console_level_colors[Color], Message);
+        if (written > 0 && (size_t)written < sizeof(buffer)) {
+            Message = buffer;
+            length = (size_t)written;
+        }
+    }
+
+    linux_write_all(fd, (const uint8*)Message, length);
+}
+
+void platform_console_write_error(const char* Message, uint8 Color) {
+    linux_console_write(STDERR_FILENO, Message, Color);
+}
+
+void platform_console_write(const char* Message, uint8 Color) {
+    linux_console_write(STDOUT_FILENO, Message, Color);
+}
+
+void platform_console_set_title(const char* title) {
+    // xterm title escape, only if there is a terminal to set it on
+    if (global_linux_state.console_colors) {
+        char buffer[512];
+        int written = snprintf(buffer, sizeof(buffer), "\x1b]0;%s\x07", title);
+        if (written > 0 && (size_t)written < sizeof(buffer)) {
+            ssize_t result = write(STDOUT_FILENO, buffer, (size_t)written);
+            (void)result;
+        }
+    }
+}
+
+// nanoseconds
+int64 platform_get_wall_clock() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (int64)now.tv_sec*1000000000LL + (int64)now.tv_nsec;
+}
+real64 platform_get_seconds_elapsed(int64 start, int64 end) {
+    return ((real64)(end - start)) * 1.0e-9;
+}
+int64 platform_get_wall_clock_frequency() {
+    return 1000000000LL;
+}
+
+void platform_sleep(uint64 ms) {
+    if (ms == 0) {
+        // Sleep(0) on windows gives up the rest of the time slice
+        sched_yield();
+        return;
+    }
+
+    struct timespec duration;
+    duration.tv_sec  = (time_t)(ms / 1000);
+    duration.tv_nsec = (long)((ms % 1000) * 1000000);
+    while (nanosleep(&duration, &duration) != 0 && errno == EINTR) {
+    }
+}
+void platform_sleep_until(int64 wall_clock) {
+    // same clock as platform_get_wall_clock. the deadline is absolute, so a signal
+    // in the middle doesn't make it drift
+    struct timespec deadline;
+    deadline.tv_sec  = (time_t)(wall_clock / 1000000000LL);
+    deadline.tv_nsec = (long)(wall_clock % 1000000000LL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+}
+
+void platform_cpu_pause() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// threading
+struct linux_thread {
+    pthread_t thread;
+    platform_thread_func func;
+    void* data;
+};
+internal_func void* linux_thread_proc(void* param) {
+    linux_thread* thread = (linux_thread*)param;
+    return (void*)(uintptr_t)thread->func(thread->data);
+}
+
+void* platform_create_thread(platform_thread_func func, void* data) {
+    linux_thread* thread = (linux_thread*)malloc(sizeof(linux_thread));
+    if (!thread) {
+        return nullptr;
+    }
+    thread->func = func;
+    thread->data = data;
+
+    if (pthread_create(&thread->thread, NULL, linux_thread_proc, thread) != 0) {
+        free(thread);
+        return nullptr;
+    }
+    return thread;
+}
+void platform_join_thread(void* thread) {
+    pthread_join(((linux_thread*)thread)->thread, NULL);
+    free(thread);
+}
+
+// POSIX semaphores have no max count, and can only time out against CLOCK_REALTIME,
+// so build one that behaves like the windows semaphore
+struct linux_semaphore {
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    uint32 count;
+    uint32 max_count;
+};
+
+void* platform_create_semaphore(uint32 initial_count, uint32 max_count) {
+    linux_semaphore* semaphore = (linux_semaphore*)malloc(sizeof(linux_semaphore));
+    if (!semaphore) {
+        return nullptr;
+    }
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_mutex_init(&semaphore->mutex, NULL);
+    pthread_cond_init(&semaphore->cond, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+    semaphore->count = initial_count;
+    semaphore->max_count = max_count;
+    return semaphore;
+}
+void platform_destroy_semaphore(void* semaphore) {
+    linux_semaphore* sem = (linux_semaphore*)semaphore;
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->mutex);
+    free(sem);
+}
+void platform_signal_semaphore(void* semaphore) {
+    linux_semaphore* sem = (linux_semaphore*)semaphore;
+    pthread_mutex_lock(&sem->mutex);
+    if (sem->count < sem->max_count) {
+        sem->count++;
+        pthread_cond_signal(&sem->cond);
+    }
+    pthread_mutex_unlock(&sem->mutex);
+}
+bool32 platform_wait_semaphore(void* semaphore, uint32 timeout_ms) {
+    linux_semaphore* sem = (linux_semaphore*)semaphore;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec  += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&sem->mutex);
+    while (sem->count == 0) {
+        if (pthread_cond_timedwait(&sem->cond, &sem->mutex, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    bool32 signaled = sem->count > 0;
+    if (signaled) {
+        sem->count--;
+    }
+    pthread_mutex_unlock(&sem->mutex);
+
+    return signaled;
+}
+
+// first cpu in a sysfs cpu list like "2,6" or "2-3". -1 if it can't be read
+internal_func int32 linux_read_first_cpu(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    char buffer[64];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0 || buffer[0] < '0' || buffer[0] > '9') {
+        return -1;
+    }
+
+    int32 cpu = 0;
+    for (ssize_t n = 0; n < length && buffer[n] >= '0' && buffer[n] <= '9'; n++) {
+        cpu = cpu*10 + (buffer[n] - '0');
+    }
+    return cpu;
+}
+
+uint32 platform_get_num_physical_cores() {
+    cpu_set_t affinity;
+    if (sched_getaffinity(0, sizeof(affinity), &affinity) != 0) {
+        return platform_get_num_logical_cores();
+    }
+
+    // a core is counted through the first of its hyperthreads we're allowed to run on
+    bool32 counted[CPU_SETSIZE] = {};
+    uint32 num_cores = 0;
+    for (int32 cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &affinity)) {
+            continue;
+        }
+
+        char path[128];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+        int32 first_sibling = linux_read_first_cpu(path);
+        if (first_sibling < 0 || first_sibling >= CPU_SETSIZE) {
+            first_sibling = cpu; // no topology, count every cpu
+        }
+        if (!counted[first_sibling]) {
+            counted[first_sibling] = true;
+            num_cores++;
+        }
+    }
+    return num_cores ? num_cores : 1;
+}
+
+uint32 platform_get_num_logical_cores() {
+    cpu_set_t affinity;
+    if (sched_getaffinity(0, sizeof(affinity), &affinity) == 0) {
+        int count = CPU_COUNT(&affinity);
+        if (count > 0) {
+            return (uint32)count;
+        }
+    }
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (uint32)count : 1;
+}
+
+void platform_swap_buffers() {
+}
+
+void platform_update_mouse() {
+}
+
+// Memory utils
+void* memory_zero(void* memory, uint64 size) {
+    return memset(memory, 0, (size_t)size);
+}
+
+void* memory_copy(void* dest, const void* src, uint64 size) {
+    return memcpy(dest, src, (size_t)size);
+}
+
+void* memory_set(void* memory, uint8 value, uint64 size) {
+    return memset(memory, value, (size_t)size);
+}
+
+// file IO
+size_t platform_get_full_resource_path(char* buffer, size_t buffer_length, const char* resource_path) {
+    AssertMsg(global_linux_state.resource_path_prefix_length, "ResourcePathPrefix is not set yet!");
+
+    size_t full_length = linux_cat_path(buffer, buffer_length,
+                                        global_linux_state.resource_path_prefix, global_linux_state.resource_path_prefix_length,
+                                        resource_path);
+    for (char* scan = buffer; *scan; scan++) {
+        if (*scan == '\\') {
+            *scan = '/';
+        }
+    }
+    return full_length;
+}
+size_t platform_get_full_library_path(char* buffer, size_t buffer_length, const char* library_path) {
+    AssertMsg(global_linux_state.library_path_prefix_length, "LibraryPathPrefix is not set yet!");
+
+    size_t full_length = linux_cat_path(buffer, buffer_length,
+                                        global_linux_state.library_path_prefix, global_linux_state.library_path_prefix_length,
+                                        library_path);
+    for (char* scan = buffer; *scan; scan++) {
+        if (*scan == '\\') {
+            *scan = '/';
+        }
+    }
+    return full_length;
+}
+
+file_handle platform_read_entire_file(const char* full_path) {
+    file_handle file = {};
+
+    int fd = open(full_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return file;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        uint64 num_bytes = (uint64)info.st_size;
+        uint8* buffer = (uint8*)platform_alloc(num_bytes + 1, 0); // +1 for null-terminator!
+        if (buffer) {
+            if (linux_read_all(fd, buffer, num_bytes)) {
+                file.num_bytes = num_bytes;
+                file.data = buffer;
+                file.data[num_bytes] = 0; // add a null-terminator just in case!
+            } else {
+                platform_free(buffer);
+            }
+        }
+    }
+
+    close(fd);
+    return file;
+}
+bool32 platform_write_entire_file(const char* full_path, const void* data, uint64 num_bytes) {
+    int fd = open(full_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    bool32 result = linux_write_all(fd, (const uint8*)data, num_bytes);
+    close(fd);
+
+    return result;
+}
+
+// mapped_file::file holds the descriptor + 1, so a zeroed mapped_file has none
+inline int linux_mapped_fd(mapped_file* file) {
+    return (int)(intptr_t)file->file - 1;
+}
+
+bool32 platform_create_mapped_file(const char* full_path, uint64 num_bytes, mapped_file* file) {
+    *file = {};
+    if (num_bytes == 0) {
+        // same as windows, there's nothing to map
+        return false;
+    }
+
+    int fd = open(full_path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    if (ftruncate(fd, (off_t)num_bytes) != 0) {
+        close(fd);
+        return false;
+    }
+
+    void* View = mmap(nullptr, (size_t)num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (View == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    file->data = (uint8*)View;
+    file->num_bytes = num_bytes;
+    file->file = (void*)(intptr_t)(fd + 1);
+    file->mapping = nullptr;
+    return true;
+}
+void platform_flush_mapped_file(mapped_file* file, uint64 offset, uint64 num_bytes) {
+    if (file->data && num_bytes > 0) {
+        // msync wants a page aligned start. MS_ASYNC doesn't wait for the disk
+        uint64 page_offset = offset & ~(linux_page_size() - 1);
+        msync(file->data + page_offset, (size_t)(num_bytes + (offset - page_offset)), MS_ASYNC);
+    }
+}
+void platform_close_mapped_file(mapped_file* file, uint64 final_size) {
+    if (file->data) {
+        munmap(file->data, (size_t)file->num_bytes);
+    }
+    if (file->file) {
+        int fd = linux_mapped_fd(file);
+        int result = ftruncate(fd, (off_t)final_size);
+        (void)result;
+        close(fd);
+    }
+
+    *file = {};
+}
+
+internal_func int linux_madvise_from_flags(uint32 flags) {
+    if (flags & PLATFORM_MAP_SEQUENTIAL) return MADV_SEQUENTIAL;
+    if (flags & PLATFORM_MAP_RANDOM)     return MADV_RANDOM;
+    return MADV_NORMAL;
+}
+
+bool32 platform_map_file(const char* full_path, mapped_file* file, uint32 flags) {
+    *file = {};
+
+    int fd = open(full_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    if (info.st_size == 0) {
+        // can't map an empty file, but it's not an error either
+        close(fd);
+        return true;
+    }
+
+    // the page cache's read-ahead window for the file
+    if (flags & PLATFORM_MAP_SEQUENTIAL) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    } else if (flags & PLATFORM_MAP_RANDOM) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+    }
+
+    // MAP_POPULATE reads the whole file and fills in the page tables before returning
+    int map_flags = MAP_PRIVATE | ((flags & PLATFORM_MAP_PREFAULT) ? MAP_POPULATE : 0);
+    void* View = mmap(nullptr, (size_t)info.st_size, PROT_READ, map_flags, fd, 0);
+    // the mapping keeps the file alive on its own
+    close(fd);
+    if (View == MAP_FAILED) {
+        return false;
+    }
+
+    // how faults on the mapping read ahead
+    int advice = linux_madvise_from_flags(flags);
+    if (advice != MADV_NORMAL) {
+        madvise(View, (size_t)info.st_size, advice);
+    }
+
+    file->data = (uint8*)View;
+    file->num_bytes = (uint64)info.st_size;
+    return true;
+}
+void platform_advise_mapped_file(mapped_file* file, uint64 offset, uint64 num_bytes, uint32 flags) {
+    if (!file->data || offset >= file->num_bytes) {
+        return;
+    }
+    if (num_bytes > file->num_bytes - offset) {
+        num_bytes = file->num_bytes - offset;
+    }
+
+    // madvise wants a page aligned start
+    uint64 page_offset = offset & ~(linux_page_size() - 1);
+    uint8* start = file->data + page_offset;
+    size_t length = (size_t)(num_bytes + (offset - page_offset));
+
+    madvise(start, length, linux_madvise_from_flags(flags));
+    if (flags & PLATFORM_MAP_PREFAULT) {
+        madvise(start, length, MADV_WILLNEED);
+    }
+}
+void platform_unmap_file(mapped_file* file) {
+    if (file->data) {
+        munmap(file->data, (size_t)file->num_bytes);
+    }
+
+    *file = {};
+}
+
+void platform_free_file_data(file_handle* handle) {
+    AssertMsg(handle, "Freeing a NULL file handle");
+    if (handle->num_bytes > 0 && handle->data) {
+        platform_free(handle->data);
+    }
+
+    handle->num_bytes = 0;
+    handle->data = 0;
+}
+
+// async reads. the files are plain descriptors, stored + 1 like mapped_file::file
+#define LINUX_MAX_READ Gigabytes(1) // read() never moves more than ~2GB at once, io_uring takes a 32 bit length
+#define LINUX_ASYNC_SHUTDOWN_BATCH   16
+#define LINUX_ASYNC_SHUTDOWN_WAIT_MS 100
+
+inline int linux_async_fd(void* file) {
+    return (int)(intptr_t)file - 1;
+}
+
+void* platform_open_async_file(const char* full_path, uint64* num_bytes) {
+    int fd = open(full_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    if (num_bytes) {
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            return nullptr;
+        }
+        *num_bytes = (uint64)info.st_size;
+    }
+    return (void*)(intptr_t)(fd + 1);
+}
+void platform_close_async_file(void* file) {
+    if (file) {
+        close(linux_async_fd(file));
+    }
+}
+
+bool32 platform_read_file_at(void* file, uint64 offset, void* buffer, uint64 num_bytes, uint64* bytes_read) {
+    int fd = linux_async_fd(file);
+    uint8* dest = (uint8*)buffer;
+    uint64 total = 0;
+    bool32 result = true;
+
+    while (total < num_bytes) {
+        uint64 chunk = num_bytes - total;
+        if (chunk > LINUX_MAX_READ) {
+            chunk = LINUX_MAX_READ;
+        }
+
+        ssize_t num_read = pread(fd, dest + total, (size_t)chunk, (off_t)(offset + total));
+        if (num_read < 0) {
+            if (errno == EINTR) continue;
+            result = false;
+            break;
+        }
+        if (num_read == 0) {
+            break; // end of the file
+        }
+        total += (uint64)num_read;
+    }
+
+    if (bytes_read) {
+        *bytes_read = total;
+    }
+    return result;
+}
+
+/*
+ * io_uring:
+ *   Reads go straight into the submission ring, and one io_uring_enter hands the whole
+ *   batch to the kernel. Completions are read out of the completion ring without a syscall,
+ *   so polling is free. Only waiting goes into the kernel.
+ *
+ *   Set up with raw syscalls (no liburing). Needs IORING_FEAT_EXT_ARG (5.11) for wait timeouts.
+ *   If io_uring is missing or blocked (older kernels, seccomp'd containers), the thread pool
+ *   in platform_async_pool.cpp is used instead.
+ * */
+struct linux_uring {
+    int fd;
+
+    void*  sq_ring;
+    size_t sq_ring_size;
+    void*  cq_ring;
+    size_t cq_ring_size;
+    struct io_uring_sqe* sqes;
+    size_t sqes_size;
+
+    // shared with the kernel
+    uint32* sq_head;
+    uint32* sq_tail;
+    uint32* sq_array;
+    uint32  sq_mask;
+    uint32* cq_head;
+    uint32* cq_tail;
+    struct io_uring_cqe* cqes;
+    uint32  cq_mask;
+
+    uint32 max_in_flight;
+    uint32 num_in_flight;  // counts a read once, even if it took a few sqes
+    uint32 num_unsubmitted; // in the ring, but io_uring_enter hasn't seen them yet
+};
+
+struct linux_async_state {
+    bool32 initialized;
+    bool32 use_uring;
+    linux_uring ring;
+};
+global_variable linux_async_state global_async_state;
+
+internal_func void linux_uring_destroy(linux_uring* ring) {
+    if (ring->sqes) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    if (ring->sq_ring) {
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    *ring = {};
+    ring->fd = -1;
+}
+
+internal_func bool32 linux_uring_init(linux_uring* ring, uint32 max_in_flight) {
+    *ring = {};
+    ring->fd = -1;
+
+    struct io_uring_params params = {};
+    int fd = (int)syscall(__NR_io_uring_setup, max_in_flight, &params);
+    if (fd < 0) {
+        return false;
+    }
+    ring->fd = fd;
+    if (!(params.features & IORING_FEAT_EXT_ARG)) {
+        linux_uring_destroy(ring);
+        return false;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries*sizeof(uint32);
+    ring->cq_ring_size = params.cq_off.cqes  + params.cq_entries*sizeof(struct io_uring_cqe);
+    bool32 single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        // both rings live in the one mapping
+        if (ring->cq_ring_size > ring->sq_ring_size) {
+            ring->sq_ring_size = ring->cq_ring_size;
+        }
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    void* sq_ring = mmap(nullptr, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+        linux_uring_destroy(ring);
+        return false;
+    }
+    ring->sq_ring = sq_ring;
+
+    if (single_mmap) {
+        ring->cq_ring = sq_ring;
+    } else {
+        void* cq_ring = mmap(nullptr, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            linux_uring_destroy(ring);
+            return false;
+        }
+        ring->cq_ring = cq_ring;
+    }
+
+    ring->sqes_size = params.sq_entries*sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        linux_uring_destroy(ring);
+        return false;
+    }
+    ring->sqes = (struct io_uring_sqe*)sqes;
+
+    uint8* sq = (uint8*)ring->sq_ring;
+    uint8* cq = (uint8*)ring->cq_ring;
+    ring->sq_head  = (uint32*)(sq + params.sq_off.head);
+    ring->sq_tail  = (uint32*)(sq + params.sq_off.tail);
+    ring->sq_array = (uint32*)(sq + params.sq_off.array);
+    ring->sq_mask  = *(uint32*)(sq + params.sq_off.ring_mask);
+    ring->cq_head  = (uint32*)(cq + params.cq_off.head);
+    ring->cq_tail  = (uint32*)(cq + params.cq_off.tail);
+    ring->cqes     = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    ring->cq_mask  = *(uint32*)(cq + params.cq_off.ring_mask);
+
+    // the kernel rounds the ring sizes up, but never down. and the completion ring is
+    // twice the size, so neither can overflow with max_in_flight reads around
+    ring->max_in_flight = max_in_flight;
+    return true;
+}
+
+// puts (the rest of) a read into the submission ring. there's always room:
+// every read in flight holds at most one sqe, and the ring fits max_in_flight of them
+internal_func void linux_uring_queue(linux_uring* ring, async_read* request) {
+    uint32 tail = *ring->sq_tail; // only we write the tail
+    uint32 index = tail & ring->sq_mask;
+
+    uint64 remaining = request->num_bytes - request->bytes_read;
+    if (remaining > LINUX_MAX_READ) {
+        remaining = LINUX_MAX_READ;
+    }
+
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = IORING_OP_READ;
+    sqe->fd        = linux_async_fd(request->file);
+    sqe->off       = request->offset + request->bytes_read;
+    sqe->addr      = (uint64)(uintptr_t)((uint8*)request->buffer + request->bytes_read);
+    sqe->len       = (uint32)remaining;
+    sqe->user_data = (uint64)(uintptr_t)request;
+
+    ring->sq_array[index] = index;
+    // the sqe has to be written before the kernel can see the new tail
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->num_unsubmitted++;
+}
+
+internal_func void linux_uring_submit(linux_uring* ring) {
+    while (ring->num_unsubmitted > 0) {
+        long result = syscall(__NR_io_uring_enter, ring->fd, ring->num_unsubmitted, 0, 0, nullptr, 0);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            break; // EAGAIN/EBUSY, try again on the next submit or poll
+        }
+        if (result == 0) {
+            break;
+        }
+        ring->num_unsubmitted -= (uint32)result;
+    }
+}
+
+// takes finished reads out of the completion ring. short reads are queued again for the rest
+internal_func uint32 linux_uring_reap(linux_uring* ring, async_read** completed, uint32 max_completed) {
+    uint32 num_completed = 0;
+    uint32 head = *ring->cq_head; // only we write the head
+    uint32 tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+
+    while (head != tail && num_completed < max_completed) {
+        struct io_uring_cqe* cqe = &ring->cqes[head & ring->cq_mask];
+        async_read* request = (async_read*)(uintptr_t)cqe->user_data;
+        int32 result = cqe->res;
+        head++;
+
+        if (result == -EINTR || result == -EAGAIN) {
+            linux_uring_queue(ring, request);
+            continue;
+        }
+        if (result < 0) {
+            request->status = ASYNC_READ_FAILED;
+        } else {
+            request->bytes_read += (uint64)result;
+            if (result > 0 && request->bytes_read < request->num_bytes) {
+                linux_uring_queue(ring, request);
+                continue;
+            }
+            // got all of it, or hit the end of the file
+            request->status = ASYNC_READ_DONE;
+        }
+
+        completed[num_completed++] = request;
+        ring->num_in_flight--;
+    }
+
+    // done with those cqes, the kernel can reuse them
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return num_completed;
+}
+
+internal_func uint32 linux_uring_wait(linux_uring* ring, async_read** completed, uint32 max_completed, uint32 timeout_ms) {
+    linux_uring_submit(ring);
+
+    int64 start = platform_get_wall_clock();
+    for (;;) {
+        uint32 num_completed = linux_uring_reap(ring, completed, max_completed);
+        linux_uring_submit(ring); // anything reap queued again
+        if (num_completed > 0 || ring->num_in_flight == 0) {
+            return num_completed;
+        }
+
+        real64 elapsed_ms = 1000.0 * platform_get_seconds_elapsed(start, platform_get_wall_clock());
+        if (elapsed_ms >= (real64)timeout_ms) {
+            return 0;
+        }
+
+        uint64 remaining_ns = (uint64)(((real64)timeout_ms - elapsed_ms) * 1000000.0);
+        struct __kernel_timespec timeout;
+        timeout.tv_sec  = (int64)(remaining_ns / 1000000000ULL);
+        timeout.tv_nsec = (int64)(remaining_ns % 1000000000ULL);
+        struct io_uring_getevents_arg arg = {};
+        arg.ts = (uint64)(uintptr_t)&timeout;
+
+        // ETIME and EINTR just go around again
+        syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    }
+}
+
+bool32 platform_async_io_init(uint32 max_in_flight) {
+    linux_async_state* state = &global_async_state;
+    AssertMsg(!state->initialized, "Async reads are already initialized!");
+    if (max_in_flight == 0) {
+        max_in_flight = 1;
+    }
+
+    if (linux_uring_init(&state->ring, max_in_flight)) {
+        state->use_uring = true;
+        RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Async reads go through io_uring, %u reads in flight.", max_in_flight);
+    } else {
+        RH_INFO_CH(LOG_CHANNEL_PLATFORM, "io_uring is not available, using a thread pool for async reads.");
+        state->use_uring = false;
+        if (!async_pool_init(max_in_flight, ASYNC_POOL_MAX_THREADS)) {
+            RH_ERROR_CH(LOG_CHANNEL_PLATFORM, "Could not start the async read threads!");
+            return false;
+        }
+    }
+
+    state->initialized = true;
+    return true;
+}
+void platform_async_io_shutdown() {
+    linux_async_state* state = &global_async_state;
+    if (!state->initialized) {
+        return;
+    }
+
+    if (state->use_uring) {
+        // the kernel is still writing into the caller's buffers, let it finish
+        async_read* completed[LINUX_ASYNC_SHUTDOWN_BATCH];
+        while (state->ring.num_in_flight > 0) {
+            linux_uring_wait(&state->ring, completed, LINUX_ASYNC_SHUTDOWN_BATCH, LINUX_ASYNC_SHUTDOWN_WAIT_MS);
+        }
+        linux_uring_destroy(&state->ring);
+    } else {
+        async_pool_shutdown();
+    }
+    state->initialized = false;
+}
+
+bool32 platform_async_read(async_read* request) {
+    linux_async_state* state = &global_async_state;
+    if (!state->use_uring) {
+        return async_pool_read(request);
+    }
+
+    linux_uring* ring = &state->ring;
+    if (ring->num_in_flight == ring->max_in_flight) {
+        return false;
+    }
+    request->status = ASYNC_READ_PENDING;
+    request->bytes_read = 0;
+    linux_uring_queue(ring, request);
+    ring->num_in_flight++;
+    return true;
+}
+void platform_async_submit() {
+    linux_async_state* state = &global_async_state;
+    if (state->use_uring) {
+        linux_uring_submit(&state->ring);
+    } else {
+        async_pool_submit();
+    }
+}
+uint32 platform_async_num_in_flight() {
+    linux_async_state* state = &global_async_state;
+    return state->use_uring ? state->ring.num_in_flight : async_pool_num_in_flight();
+}
+uint32 platform_async_poll(async_read** completed, uint32 max_completed) {
+    return platform_async_wait(completed, max_completed, 0);
+}
+uint32 platform_async_wait(async_read** completed, uint32 max_completed, uint32 timeout_ms) {
+    linux_async_state* state = &global_async_state;
+    if (state->use_uring) {
+        return linux_uring_wait(&state->ring, completed, max_completed, timeout_ms);
+    }
+    return async_pool_wait(completed, max_completed, timeout_ms);
+}
+
+// file times are kept like windows FILETIMEs (100ns intervals since 1601),
+// so they mean the same thing on every platform
+#define LINUX_FILETIME_UNIX_EPOCH 116444736000000000ULL
+internal_func uint64 linux_filetime_from_timespec(struct timespec time) {
+    return LINUX_FILETIME_UNIX_EPOCH + (uint64)time.tv_sec*10000000ULL + (uint64)time.tv_nsec/100;
+}
+
+bool32 platform_get_file_attributes(const char* full_path, file_info* info) {
+    struct stat data;
+    if (stat(full_path, &data) == 0) {
+        info->file_attributes  = (uint64)data.st_mode;
+        info->creation_time    = linux_filetime_from_timespec(data.st_ctim); // closest thing there is
+        info->last_access_time = linux_filetime_from_timespec(data.st_atim);
+        info->last_write_time  = linux_filetime_from_timespec(data.st_mtim);
+        info->file_size        = (uint64)data.st_size;
+        return true;
+    }
+
+    return false;
+}
+
+void platform_filetime_to_systime(uint64 file_time, char* buffer, uint64 buf_size) {
+    uint64 since_epoch = (file_time > LINUX_FILETIME_UNIX_EPOCH) ? file_time - LINUX_FILETIME_UNIX_EPOCH : 0;
+    time_t seconds = (time_t)(since_epoch / 10000000ULL);
+    uint32 milliseconds = (uint32)((since_epoch % 10000000ULL) / 10000ULL);
+
+    struct tm sys_time;
+    localtime_r(&seconds, &sys_time);
+
+    int hour = sys_time.tm_hour;
+    const char* am_pm = "am";
+    if (hour >= 12) {
+        hour -= 12; // get rid of 24 hour time
+        am_pm = "pm";
+    }
+    if (hour == 0)  hour  = 12; // turn hour 0 to 12:00
+
+    snprintf(buffer, (size_t)buf_size,
+             "%02d/%02d/%04d %02d:%02d:%02d.%03u %s",
+             sys_time.tm_mon + 1, sys_time.tm_mday, sys_time.tm_year + 1900,
+             hour, sys_time.tm_min, sys_time.tm_sec, milliseconds, am_pm);
+}
+
+bool32 platform_copy_file(const char* src_path, const char* dst_path) {
+    int src = open(src_path, O_RDONLY | O_CLOEXEC);
+    int dst = (src >= 0) ? open(dst_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) : -1;
+
+    bool32 result = (src >= 0 && dst >= 0);
+    uint8 buffer[64*1024];
+    while (result) {
+        ssize_t num_read = read(src, buffer, sizeof(buffer));
+        if (num_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (num_read <= 0) {
+            result = (num_read == 0);
+            break;
+        }
+        result = linux_write_all(dst, buffer, (uint64)num_read);
+    }
+
+    int code = errno;
+    if (src >= 0) close(src);
+    if (dst >= 0) close(dst);
+
+    if (result) return true;
+
+    RH_ERROR_CH(LOG_CHANNEL_PLATFORM, "Could not copy file from '%s' to '%s'. Error:[%d]", src_path, dst_path, code);
+    return false;
+}
+
+bool32 platform_move_file(const char* src_path, const char* dst_path) {
+    // replaces dst_path atomically
+    return rename(src_path, dst_path) == 0;
+}
+
+void* platform_load_shared_library(const char* lib_path) {
+    return dlopen(lib_path, RTLD_NOW | RTLD_LOCAL);
+}
+void* platform_get_func_from_lib(void* shared_lib, const char* func_name) {
+    return dlsym(shared_lib, func_name);
+}
+void platform_unload_shared_library(void* shared_lib) {
+    dlclose(shared_lib);
+}
+
+// no window in headless mode
+void* platform_get_raw_handle() {
+    return nullptr;
+}
+uint32 platform_get_window_id() {
+    return 0;
+}
+
+#endif //#ifdef RH_PLATFORM_LINUX
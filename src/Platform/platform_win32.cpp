@@ -1,8 +1,11 @@
 #include "Platform.h"
+#include "platform_async_pool.h"
 
 #include "Core/Logger.h"
+#include "Core/Logger_Binary.h"
 #include "Core/Asserts.h"
 #include "Core/Event.h"
+#include "Core/Event_Listeners.h"
 #include "Memory/Memory.h"
 #include "Core/Input.h"
 #include "Core/String.h"
@@ -11,11 +14,17 @@
 
 #include <Windows.h>
 #include <shlwapi.h>
+#include <shellapi.h>
 #include <strsafe.h>
 #include <windowsx.h>
 #include <stdarg.h>
 #include <stdio.h>
 
+// older SDKs don't have it
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 // https://learn.microsoft.com/en-us/windows/win32/dxtecharts/taking-advantage-of-high-dpi-mouse-movement?redirectedfrom=MSDN#wm_input
 // you can #include <hidusage.h> for these defines
 #ifndef HID_USAGE_PAGE_GENERIC
@@ -42,7 +51,9 @@ struct PlatformState {
     uint64 library_path_prefix_length;
 
     WINDOWPLACEMENT window_position; // save the last window position for fullscreen purposes
+    int64 performance_counter_frequency;
     real64 inv_performance_counter_frequency;
+    HANDLE wait_timer; // for platform_sleep_until
 
     RECT mouse_rect;
     RECT mouse_rect_full;
@@ -129,21 +140,21 @@ bool32 platform_setup_paths() {
     // regardless, so we do this rigamarole.
     char cwd[WIN32_STATE_FILE_NAME_COUNT];
     if (!GetCurrentDirectory(WIN32_STATE_FILE_NAME_COUNT, cwd)) return false;
-    RH_INFO("Current Working Directory: [%s]", cwd);
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Current Working Directory: [%s]", cwd);
 
     // 1.  find the .exe filename! this includes /path/to/game.exe
     //    so we strip everything after the last /
     if (!GetModuleFileNameA(NULL, global_win32_state.exe_path, WIN32_STATE_FILE_NAME_COUNT)) return false;
-    RH_INFO("EXE filename: [%s]", global_win32_state.exe_path);
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "EXE filename: [%s]", global_win32_state.exe_path);
     string_replace(global_win32_state.exe_path, WIN32_STATE_FILE_NAME_COUNT, '/', '\\');
     global_win32_state.exe_path_len = 1+string_find_last(global_win32_state.exe_path, global_win32_state.exe_path+WIN32_STATE_FILE_NAME_COUNT, '\\'); // add 1 to get the trailing slash
     global_win32_state.exe_path[global_win32_state.exe_path_len] = 0;
-    RH_INFO("EXE path:     [%s]", global_win32_state.exe_path);
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "EXE path:     [%s]", global_win32_state.exe_path);
 
     // 2.  cwd into the exe path, so we start next to the .exe always
     if (!SetCurrentDirectory(global_win32_state.exe_path)) return false;
     if (!GetCurrentDirectory(WIN32_STATE_FILE_NAME_COUNT, cwd)) return false;
-    RH_INFO("Current Working Directory: [%s]", cwd);
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Current Working Directory: [%s]", cwd);
 
     // 2.5 In a 'release' build, this would be in the /Game/run_tree/ dir
     //     right next to the Data/ directory. For development however, 
@@ -152,13 +163,13 @@ bool32 platform_setup_paths() {
     if (PathFileExistsA(".\\Data\\")) {
         // we are in the run_tree directory
         if (!GetCurrentDirectory(WIN32_STATE_FILE_NAME_COUNT, cwd)) return false;
-        RH_INFO("Current Working Directory: [%s]", cwd);
+        RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Current Working Directory: [%s]", cwd);
     } else {
         #if RH_INTERNAL
         // we are in the bin directory
         if (!SetCurrentDirectory("..\\Game\\run_tree\\")) return false;
         if (!GetCurrentDirectory(WIN32_STATE_FILE_NAME_COUNT, cwd)) return false;
-        RH_INFO("Current Working Directory: [%s]", cwd);
+        RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Current Working Directory: [%s]", cwd);
         #endif
     }
 
@@ -237,7 +248,7 @@ void platform_init_logging(bool32 create_console) {
     // setup console defaults
     if (create_console) {
         AllocConsole();
-        RH_DEBUG("Creating new console");
+        RH_DEBUG_CH(LOG_CHANNEL_PLATFORM, "Creating new console");
     }
     global_win32_state.alloced_console = create_console;
 
@@ -265,14 +276,23 @@ bool32 platform_startup(AppConfig* config) {
     LARGE_INTEGER PerfCounterFrequencyResult;
     QueryPerformanceFrequency(&PerfCounterFrequencyResult);
     int64 performance_counter_frequency = PerfCounterFrequencyResult.QuadPart;
+    global_win32_state.performance_counter_frequency = performance_counter_frequency;
     global_win32_state.inv_performance_counter_frequency = 1.0 / ((real64)performance_counter_frequency);
 
+    // high resolution timers (windows 10 1803+) aren't rounded to the scheduler tick.
+    // older versions only have the regular kind
+    global_win32_state.wait_timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!global_win32_state.wait_timer) {
+        RH_WARN_CH(LOG_CHANNEL_PLATFORM, "No high resolution timer, sleeps will be rounded to 1ms.");
+        global_win32_state.wait_timer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+    }
+
     // NOTE: Set the Windows scheduler granularity to 1ms
     //       so that our Sleep can be more granular
     {
         UINT DesiredSchedulerMS = 1;
         if (!(timeBeginPeriod(DesiredSchedulerMS) == TIMERR_NOERROR)) {
-            RH_ERROR("Could not set Windows scheduler granularity to 1ms!");
+            RH_ERROR_CH(LOG_CHANNEL_PLATFORM, "Could not set Windows scheduler granularity to 1ms!");
             // could still run techincally? won't return false
         }
     }
@@ -336,7 +356,7 @@ bool32 platform_startup(AppConfig* config) {
 
     if (!global_win32_state.window) {
         MessageBoxA(0, "Failed to create window.", "Error", MB_ICONEXCLAMATION | MB_OK);
-        RH_FATAL("Window creation failed!");
+        RH_FATAL_CH(LOG_CHANNEL_PLATFORM, "Window creation failed!");
         return false;
     }
 
@@ -344,6 +364,9 @@ bool32 platform_startup(AppConfig* config) {
 
     ShowWindow(global_win32_state.window, SW_SHOW);
 
+    // files dragged onto the window get fired as EVENT_CODE_FILE_DROPPED
+    DragAcceptFiles(global_win32_state.window, TRUE);
+
     GetClipCursor(&global_win32_state.mouse_rect_full);
     //GetWindowRect(global_win32_state.window, &client_rect);
     //GetClientRect(global_win32_state.window, &mouse_Rect);
@@ -373,16 +396,29 @@ void platform_shutdown() {
     if (global_win32_state.alloced_console){
         FreeConsole();
     }
+    if (global_win32_state.wait_timer) {
+        CloseHandle(global_win32_state.wait_timer);
+        global_win32_state.wait_timer = NULL;
+    }
     // don't really need to do anything here...
-    RH_INFO("Shutting down the platform layer.");
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Shutting down the platform layer.");
 }
 
 bool32 platform_process_messages() {
+    // message times are in GetTickCount() milliseconds, so convert their age to the wall clock
+    int64 now = platform_get_wall_clock();
+    DWORD now_ticks = GetTickCount();
+    real64 counts_per_ms = 0.001 / global_win32_state.inv_performance_counter_frequency;
+
     MSG Message;
     while (PeekMessageA(&Message, NULL, 0, 0, PM_REMOVE)) {
+        DWORD age_ms = now_ticks - Message.time;
+        input_set_arrival_time((age_ms < 1000) ? now - (int64)((real64)age_ms * counts_per_ms) : 0);
+
         TranslateMessage(&Message);
         DispatchMessageA(&Message);
     }
+    input_set_arrival_time(0);
     return true;
 }
 
@@ -409,7 +445,7 @@ bool32 platform_assert_message(const char* fmt, ...) {
                                     "Assertion Failed! Ignore?", 
                                     MB_YESNO | MB_ICONEXCLAMATION | MB_DEFBUTTON1 | MB_TASKMODAL);
 
-    RH_INFO("You pressed button [%d] in response", button_pressed);
+    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "You pressed button [%d] in response", button_pressed);
     if (button_pressed == IDYES) {
         return false;
     }
@@ -440,14 +476,8 @@ void platform_console_write(const char* Message, uint8 Color) {
     SetConsoleTextAttribute(console_handle, global_win32_state.default_console_attributes_out);
 }
 
-void platform_console_set_title(const char* Message, ...) {
-
-    char title_buffer[256];
-    va_list args;
-    va_start(args, Message);
-    vsnprintf(title_buffer, sizeof(title_buffer), Message, args);
-    va_end(args);
-    SetConsoleTitleA(title_buffer);
+void platform_console_set_title(const char* title) {
+    SetConsoleTitleA(title);
 }
 
 int64 platform_get_wall_clock() {
@@ -460,10 +490,115 @@ real64 platform_get_seconds_elapsed(int64 start, int64 end) {
     return ((real64)(end - start)) * global_win32_state.inv_performance_counter_frequency;
 }
 
+int64 platform_get_wall_clock_frequency() {
+    return global_win32_state.performance_counter_frequency;
+}
+
 void platform_sleep(uint64 ms) {
     Sleep((DWORD)ms);
 }
 
+void platform_sleep_until(int64 wall_clock) {
+    int64 ticks = wall_clock - platform_get_wall_clock();
+    if (ticks <= 0) {
+        return;
+    }
+
+    // absolute due times are on the system clock, not the performance counter, so use a
+    // relative one. it's in 100ns units, negative for relative
+    LARGE_INTEGER DueTime;
+    DueTime.QuadPart = -(LONGLONG)((real64)ticks * global_win32_state.inv_performance_counter_frequency * 1.0e7);
+    if (DueTime.QuadPart == 0) {
+        return;
+    }
+
+    if (global_win32_state.wait_timer && SetWaitableTimer(global_win32_state.wait_timer, &DueTime, 0, NULL, NULL, FALSE)) {
+        WaitForSingleObject(global_win32_state.wait_timer, INFINITE);
+    } else {
+        Sleep((DWORD)(ticks * 1000 / global_win32_state.performance_counter_frequency));
+    }
+}
+
+void platform_cpu_pause() {
+    YieldProcessor();
+}
+
+// threading
+struct win32_thread_start {
+    platform_thread_func func;
+    void* data;
+};
+internal_func DWORD WINAPI win32_thread_proc(LPVOID param) {
+    win32_thread_start start = *(win32_thread_start*)param;
+    HeapFree(GetProcessHeap(), 0, param);
+
+    return (DWORD)start.func(start.data);
+}
+
+void* platform_create_thread(platform_thread_func func, void* data) {
+    win32_thread_start* start = (win32_thread_start*)HeapAlloc(GetProcessHeap(), 0, sizeof(win32_thread_start));
+    if (!start) {
+        return nullptr;
+    }
+    start->func = func;
+    start->data = data;
+
+    HANDLE thread = CreateThread(NULL, 0, win32_thread_proc, start, 0, NULL);
+    if (!thread) {
+        HeapFree(GetProcessHeap(), 0, start);
+        return nullptr;
+    }
+    return thread;
+}
+void platform_join_thread(void* thread) {
+    WaitForSingleObject((HANDLE)thread, INFINITE);
+    CloseHandle((HANDLE)thread);
+}
+
+void* platform_create_semaphore(uint32 initial_count, uint32 max_count) {
+    return CreateSemaphoreA(NULL, (LONG)initial_count, (LONG)max_count, NULL);
+}
+void platform_destroy_semaphore(void* semaphore) {
+    CloseHandle((HANDLE)semaphore);
+}
+void platform_signal_semaphore(void* semaphore) {
+    ReleaseSemaphore((HANDLE)semaphore, 1, NULL);
+}
+bool32 platform_wait_semaphore(void* semaphore, uint32 timeout_ms) {
+    return WaitForSingleObject((HANDLE)semaphore, (DWORD)timeout_ms) == WAIT_OBJECT_0;
+}
+
+uint32 platform_get_num_physical_cores() {
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+    if (length == 0) {
+        return platform_get_num_logical_cores();
+    }
+
+    uint8* buffer = (uint8*)platform_alloc(length, 0);
+    uint32 num_cores = 0;
+    if (buffer && GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buffer, &length)) {
+        // one variable-sized record per core
+        for (DWORD offset = 0; offset < length; ) {
+            PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buffer + offset);
+            if (info->Relationship == RelationProcessorCore) {
+                num_cores++;
+            }
+            offset += info->Size;
+        }
+    }
+    if (buffer) {
+        platform_free(buffer);
+    }
+
+    return num_cores ? num_cores : platform_get_num_logical_cores();
+}
+
+uint32 platform_get_num_logical_cores() {
+    DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    return count ? (uint32)count : 1;
+}
+
 
 bool32 win32_toggle_fullscreen(HWND Window, WINDOWPLACEMENT* WindowPos) {
     // TODO: Look into ChangeDisplaySettings function to change monitor refresh rate/resolution
@@ -502,13 +637,14 @@ void win32_update_mouse_rect(HWND window, long new_width, long new_height, RECT*
 }
 
 LRESULT CALLBACK win32_window_callback(HWND window, uint32 message, WPARAM w_param, LPARAM l_param) {
-    event_context no_data = {};
     switch (message) {
         case WM_ERASEBKGND:
             return 1;
-        case WM_CLOSE:
-            event_fire(EVENT_CODE_APPLICATION_QUIT, 0, no_data);
+        case WM_CLOSE: {
+            event_application_quit quit_event = {};
+            event_fire_typed(quit_event);
             return 0;
+        }
         case WM_DESTROY:
             return 0;
         case WM_SIZE: {
@@ -517,10 +653,9 @@ LRESULT CALLBACK win32_window_callback(HWND window, uint32 message, WPARAM w_par
             uint32 width  = client_rect.right - client_rect.left;
             uint32 height = client_rect.bottom - client_rect.top;
 
-            event_context context;
-            context.u32[0] = width;
-            context.u32[1] = height;
-            event_fire(EVENT_CODE_RESIZED, 0, context); // this will generate tons of resize messages, beware!
+            // this will generate tons of resize messages, beware!
+            event_resized resize_event = { width, height };
+            event_fire_typed(resize_event);
             
             win32_update_mouse_rect(window, (long)width, (long)height, &global_win32_state.mouse_rect);
             if (global_win32_state.capture_mouse) {
@@ -549,17 +684,17 @@ LRESULT CALLBACK win32_window_callback(HWND window, uint32 message, WPARAM w_par
                 key = is_extended ? KEY_RCONTROL : KEY_LCONTROL;
             }
 
-            //RH_DEBUG("Key [%s]=[%d] %s", input_get_key_string(key), key, pressed ? "down" : "up");
+            RH_DEBUG_BIN_CH(LOG_CHANNEL_PLATFORM, "Key [%s]=[%d] %s", input_get_key_string(key), key, pressed ? "down" : "up");
 
             input_process_key(key, (uint8)pressed);
 
             bool32 AltKeyWasDown = (l_param & (1 << 29));
             if (pressed && AltKeyWasDown) {
                 if (key == KEY_RETURN) {
-                    RH_INFO("Toggle Fullscreen");
+                    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Toggle Fullscreen");
                     global_win32_state.is_fullscreen = win32_toggle_fullscreen(global_win32_state.window, &global_win32_state.window_position);
                 } else if (key == KEY_M) {
-                    RH_INFO("Toggle mouse capture");
+                    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Toggle mouse capture");
                     global_win32_state.capture_mouse = !global_win32_state.capture_mouse;
                     if (global_win32_state.capture_mouse) {
                         ClipCursor(&global_win32_state.mouse_rect);
@@ -567,7 +702,7 @@ LRESULT CALLBACK win32_window_callback(HWND window, uint32 message, WPARAM w_par
                         ClipCursor(&global_win32_state.mouse_rect_full);
                     }
                 } else if (key == KEY_H) {
-                    RH_INFO("Toggle mouse hide");
+                    RH_INFO_CH(LOG_CHANNEL_PLATFORM, "Toggle mouse hide");
                     global_win32_state.hide_mouse = !global_win32_state.hide_mouse;
                     if (global_win32_state.hide_mouse) {
                         ShowCursor(FALSE);
@@ -579,6 +714,22 @@ LRESULT CALLBACK win32_window_callback(HWND window, uint32 message, WPARAM w_par
 
             return 0;
         } break;
+        case WM_DROPFILES: {
+            HDROP drop = (HDROP)w_param;
+            UINT num_files = DragQueryFileA(drop, 0xFFFFFFFF, NULL, 0);
+            for (UINT n = 0; n < num_files; n++) {
+                UINT path_length = DragQueryFileA(drop, n, NULL, 0);
+
+                // write the path straight into the payload, no temp buffer
+                event_payload* payload = event_alloc_payload(path_length + 1);
+                if (payload) {
+                    DragQueryFileA(drop, n, (LPSTR)payload->data, path_length + 1);
+                    event_fire_payload(EVENT_CODE_FILE_DROPPED, 0, payload);
+                }
+            }
+            DragFinish(drop);
+            return 0;
+        } break;
         case WM_MOUSEMOVE: {
             int32 x_pos = GET_X_LPARAM(l_param);
             int32 y_pos = GET_Y_LPARAM(l_param);
@@ -599,7 +750,7 @@ LRESULT CALLBACK win32_window_callback(HWND window, uint32 message, WPARAM w_par
                 int xPosRelative = raw->data.mouse.lLastX;
                 int yPosRelative = raw->data.mouse.lLastY;
 
-                //RH_TRACE("Mouse dx: %d", xPosRelative);
+                RH_TRACE_BIN_CH(LOG_CHANNEL_PLATFORM, "Mouse dx: %d", xPosRelative);
                 input_process_raw_mouse_move(xPosRelative, yPosRelative);
             } 
             break;
@@ -743,7 +894,7 @@ file_handle platform_read_entire_file(const char* full_path) {
 
                     CloseHandle(FileHandle);
 
-                    //RH_TRACE("File: %s\n"
+                    //RH_TRACE_CH(LOG_CHANNEL_PLATFORM, "File: %s\n"
                     //         "               %llu Bytes", full_path, file.num_bytes);
 
                     return file;
@@ -756,6 +907,176 @@ file_handle platform_read_entire_file(const char* full_path) {
 
     return file;
 }
+bool32 platform_write_entire_file(const char* full_path, const void* data, uint64 num_bytes) {
+    AssertMsg(num_bytes <= 0xFFFFFFFF, "Can only write files up to 4GB!");
+
+    HANDLE FileHandle = CreateFileA(full_path, 
+                                    GENERIC_WRITE, 0, NULL, 
+                                    CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == FileHandle) {
+        return false;
+    }
+
+    DWORD BytesWritten = 0;
+    BOOL Result = WriteFile(FileHandle, data, (DWORD)num_bytes, &BytesWritten, NULL);
+    CloseHandle(FileHandle);
+
+    return Result && (BytesWritten == num_bytes);
+}
+bool32 platform_create_mapped_file(const char* full_path, uint64 num_bytes, mapped_file* file) {
+    *file = {};
+
+    HANDLE FileHandle = CreateFileA(full_path, 
+                                    GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, 
+                                    CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == FileHandle) {
+        return false;
+    }
+
+    // creating the mapping also grows the file to num_bytes
+    DWORD SizeHigh = (DWORD)(num_bytes >> 32);
+    DWORD SizeLow  = (DWORD)(num_bytes & 0xFFFFFFFF);
+    HANDLE MappingHandle = CreateFileMappingA(FileHandle, NULL, PAGE_READWRITE, SizeHigh, SizeLow, NULL);
+    if (MappingHandle == NULL) {
+        CloseHandle(FileHandle);
+        return false;
+    }
+
+    void* View = MapViewOfFile(MappingHandle, FILE_MAP_WRITE, 0, 0, (SIZE_T)num_bytes);
+    if (View == NULL) {
+        CloseHandle(MappingHandle);
+        CloseHandle(FileHandle);
+        return false;
+    }
+
+    file->data = (uint8*)View;
+    file->num_bytes = num_bytes;
+    file->file = FileHandle;
+    file->mapping = MappingHandle;
+    return true;
+}
+void platform_flush_mapped_file(mapped_file* file, uint64 offset, uint64 num_bytes) {
+    if (file->data && num_bytes > 0) {
+        // hands the dirty pages to the cache manager, without waiting on the disk (no FlushFileBuffers)
+        FlushViewOfFile(file->data + offset, (SIZE_T)num_bytes);
+    }
+}
+void platform_close_mapped_file(mapped_file* file, uint64 final_size) {
+    if (file->data) {
+        UnmapViewOfFile(file->data);
+    }
+    if (file->mapping) {
+        CloseHandle((HANDLE)file->mapping);
+    }
+    if (file->file) {
+        LARGE_INTEGER Size;
+        Size.QuadPart = (LONGLONG)final_size;
+        if (SetFilePointerEx((HANDLE)file->file, Size, NULL, FILE_BEGIN)) {
+            SetEndOfFile((HANDLE)file->file);
+        }
+        CloseHandle((HANDLE)file->file);
+    }
+
+    *file = {};
+}
+
+// reads the range in with large i/os, then touches every page so they're all mapped in
+internal_func void win32_prefault_range(uint8* data, uint64 num_bytes) {
+    WIN32_MEMORY_RANGE_ENTRY Range;
+    Range.VirtualAddress = data;
+    Range.NumberOfBytes  = (SIZE_T)num_bytes;
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &Range, 0);
+
+    SYSTEM_INFO SystemInfo;
+    GetSystemInfo(&SystemInfo);
+    volatile uint32 sum = 0;
+    for (uint64 offset = 0; offset < num_bytes; offset += SystemInfo.dwPageSize) {
+        sum += data[offset];
+    }
+}
+
+bool32 platform_map_file(const char* full_path, mapped_file* file, uint32 flags) {
+    *file = {};
+
+    // the cache manager reads ahead (or doesn't) for the file based on these
+    DWORD FileFlags = FILE_ATTRIBUTE_NORMAL;
+    if (flags & PLATFORM_MAP_SEQUENTIAL) {
+        FileFlags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (flags & PLATFORM_MAP_RANDOM) {
+        FileFlags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    HANDLE FileHandle = CreateFileA(full_path, 
+                                    GENERIC_READ, FILE_SHARE_READ, NULL, 
+                                    OPEN_EXISTING, FileFlags, NULL);
+    if (INVALID_HANDLE_VALUE == FileHandle) {
+        return false;
+    }
+
+    LARGE_INTEGER FileSize;
+    if (!GetFileSizeEx(FileHandle, &FileSize)) {
+        CloseHandle(FileHandle);
+        return false;
+    }
+    if (FileSize.QuadPart == 0) {
+        // can't map an empty file, but it's not an error either
+        CloseHandle(FileHandle);
+        return true;
+    }
+
+    HANDLE MappingHandle = CreateFileMappingA(FileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (MappingHandle == NULL) {
+        CloseHandle(FileHandle);
+        return false;
+    }
+
+    void* View = MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (View == NULL) {
+        CloseHandle(MappingHandle);
+        CloseHandle(FileHandle);
+        return false;
+    }
+
+    file->data = (uint8*)View;
+    file->num_bytes = (uint64)FileSize.QuadPart;
+    file->file = FileHandle;
+    file->mapping = MappingHandle;
+
+    if (flags & PLATFORM_MAP_PREFAULT) {
+        win32_prefault_range(file->data, file->num_bytes);
+    }
+    return true;
+}
+void platform_advise_mapped_file(mapped_file* file, uint64 offset, uint64 num_bytes, uint32 flags) {
+    if (!file->data || offset >= file->num_bytes) {
+        return;
+    }
+    if (num_bytes > file->num_bytes - offset) {
+        num_bytes = file->num_bytes - offset;
+    }
+
+    // there's no per-range read-ahead hint for views, only prefetching
+    if (flags & PLATFORM_MAP_PREFAULT) {
+        WIN32_MEMORY_RANGE_ENTRY Range;
+        Range.VirtualAddress = file->data + offset;
+        Range.NumberOfBytes  = (SIZE_T)num_bytes;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &Range, 0);
+    }
+}
+void platform_unmap_file(mapped_file* file) {
+    if (file->data) {
+        UnmapViewOfFile(file->data);
+    }
+    if (file->mapping) {
+        CloseHandle((HANDLE)file->mapping);
+    }
+    if (file->file) {
+        CloseHandle((HANDLE)file->file);
+    }
+
+    *file = {};
+}
+
 void platform_free_file_data(file_handle* handle) {
     AssertMsg(handle, "Freeing a NULL file handle");
     if (handle->num_bytes > 0 && handle->data) {
@@ -766,6 +1087,99 @@ void platform_free_file_data(file_handle* handle) {
     handle->data = 0;
 }
 
+// async reads go through the thread pool in platform_async_pool.cpp
+#define WIN32_MAX_READ Gigabytes(1) // ReadFile takes a 32 bit length
+
+void* platform_open_async_file(const char* full_path, uint64* num_bytes) {
+    HANDLE FileHandle = CreateFileA(full_path,
+                                    GENERIC_READ, FILE_SHARE_READ, NULL,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == FileHandle) {
+        return nullptr;
+    }
+
+    if (num_bytes) {
+        LARGE_INTEGER FileSizeBytes;
+        if (!GetFileSizeEx(FileHandle, &FileSizeBytes)) {
+            CloseHandle(FileHandle);
+            return nullptr;
+        }
+        *num_bytes = (uint64)FileSizeBytes.QuadPart;
+    }
+    return FileHandle;
+}
+void platform_close_async_file(void* file) {
+    if (file) {
+        CloseHandle((HANDLE)file);
+    }
+}
+
+bool32 platform_read_file_at(void* file, uint64 offset, void* buffer, uint64 num_bytes, uint64* bytes_read) {
+    uint8* dest = (uint8*)buffer;
+    uint64 total = 0;
+    bool32 result = true;
+
+    while (total < num_bytes) {
+        uint64 chunk = num_bytes - total;
+        if (chunk > WIN32_MAX_READ) {
+            chunk = WIN32_MAX_READ;
+        }
+
+        // the handle isn't opened for overlapped i/o, so this still blocks. but the offset comes from
+        // the OVERLAPPED instead of the file pointer, so several threads can read the same file at once
+        uint64 position = offset + total;
+        OVERLAPPED Overlapped = {};
+        Overlapped.Offset     = (DWORD)(position & 0xFFFFFFFF);
+        Overlapped.OffsetHigh = (DWORD)(position >> 32);
+
+        DWORD BytesRead = 0;
+        if (!ReadFile((HANDLE)file, dest + total, (DWORD)chunk, &BytesRead, &Overlapped)) {
+            if (GetLastError() != ERROR_HANDLE_EOF) {
+                result = false;
+            }
+            break;
+        }
+        if (BytesRead == 0) {
+            break; // end of the file
+        }
+        total += BytesRead;
+    }
+
+    if (bytes_read) {
+        *bytes_read = total;
+    }
+    return result;
+}
+
+bool32 platform_async_io_init(uint32 max_in_flight) {
+    if (max_in_flight == 0) {
+        max_in_flight = 1;
+    }
+    if (!async_pool_init(max_in_flight, ASYNC_POOL_MAX_THREADS)) {
+        RH_ERROR_CH(LOG_CHANNEL_PLATFORM, "Could not start the async read threads!");
+        return false;
+    }
+    return true;
+}
+void platform_async_io_shutdown() {
+    async_pool_shutdown();
+}
+bool32 platform_async_read(async_read* request) {
+    return async_pool_read(request);
+}
+void platform_async_submit() {
+    async_pool_submit();
+}
+uint32 platform_async_num_in_flight() {
+    return async_pool_num_in_flight();
+}
+uint32 platform_async_poll(async_read** completed, uint32 max_completed) {
+    return async_pool_wait(completed, max_completed, 0);
+}
+uint32 platform_async_wait(async_read** completed, uint32 max_completed, uint32 timeout_ms) {
+    return async_pool_wait(completed, max_completed, timeout_ms);
+}
+
 //struct file_info {
 //    uint64 file_attributes;
 //    uint64 creation_time;
@@ -803,7 +1217,7 @@ bool32 platform_get_file_attributes(const char* full_path, file_info* info) {
         return true;
     }
 
-    //RH_TRACE("Could not get file-info for '%s'", full_path);
+    //RH_TRACE_CH(LOG_CHANNEL_PLATFORM, "Could not get file-info for '%s'", full_path);
     return false;
 }
 
@@ -837,10 +1251,14 @@ bool32 platform_copy_file(const char* src_path, const char* dst_path) {
     if (CopyFileA(src_path, dst_path, FALSE) != 0) return true;
 
     DWORD code = GetLastError();
-    RH_ERROR("Could not copy file from '%s' to '%s'. Error:[%u]", src_path, dst_path, code);
+    RH_ERROR_CH(LOG_CHANNEL_PLATFORM, "Could not copy file from '%s' to '%s'. Error:[%u]", src_path, dst_path, code);
     return false;
 }
 
+bool32 platform_move_file(const char* src_path, const char* dst_path) {
+    return MoveFileExA(src_path, dst_path, MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
 void* platform_load_shared_library(const char* lib_path) {
     return LoadLibraryA(lib_path);
 }
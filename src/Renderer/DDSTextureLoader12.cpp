@@ -14,6 +14,9 @@
 // http://go.microsoft.com/fwlink/?LinkID=615561
 //--------------------------------------------------------------------------------------
 
+// only used by the DX12 renderer
+#ifdef _WIN32
+
 #include "DDSTextureLoader12.h"
 
 #include <algorithm>
@@ -1841,3 +1844,5 @@ HRESULT DirectX::LoadDDSTextureFromFileEx(
 
     return hr;
 }
+
+#endif // _WIN32
@@ -1,9 +1,15 @@
 #include "Renderer.h"
 
-#include "Platform/platform.h"
+// the null renderer (Renderer_Null.cpp) is used everywhere else
+#ifdef RH_PLATFORM_WINDOWS
+
+#include "Platform/Platform.h"
 #include "Core/Asserts.h"
 #include "Memory/Memory_Arena.h"
 #include "Memory/Memory.h"
+#include "Core/String_Utf.h"
+#include "Core/Input_Latency.h"
+#include "Core/File_Batch.h"
 #include "Render_Types.h"
 
 // DirectX 12 headers.
@@ -38,17 +44,56 @@
 #define MAX_OBJECTS 1024
 #define MAX_OBJECTS_STR ToString(MAX_OBJECTS)
 
-Texture_Handle renderer_create_texture(const wchar_t* filename);
+Texture_Handle renderer_create_texture(const char* filename);
 
 void set_vertex_buffer(ID3D12GraphicsCommandList* cmdlist, const Render_Geometry* geom);
-Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromFile(const wchar_t* filename, 
+Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromFile(const char* filename, 
                                                              Microsoft::WRL::ComPtr<ID3D12Resource>* tex_resource,
                                                              Renderer_Texture* tex,
                                                              ID3D12GraphicsCommandList* cmdlist,
                                                              ID3D12DescriptorHeap* heap,
                                                              uint32 heapsize);
+Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromMemory(const char* filename,
+                                                               const uint8* dds_data,
+                                                               uint64 dds_size,
+                                                               Microsoft::WRL::ComPtr<ID3D12Resource>* tex_resource,
+                                                               Renderer_Texture* tex,
+                                                               ID3D12GraphicsCommandList* cmdlist,
+                                                               ID3D12DescriptorHeap* heap,
+                                                               uint32 heapsize,
+                                                               uint32 descriptor_index);
 inline uint32 Real32AsUint32(real32 v);
 
+// next free SRV slot in the CBV_SRV_UAV heap
+global_variable uint32 next_texture_descriptor = 0;
+
+// textures loaded together through a file batch
+struct texture_load_target {
+    Microsoft::WRL::ComPtr<ID3D12Resource>* resource;
+    Renderer_Texture* texture;
+    uint32 descriptor_index; // picked up front, files can finish in any order
+};
+struct texture_batch {
+    texture_load_target* targets;
+    Microsoft::WRL::ComPtr<ID3D12Resource>* upload_buffers;
+    ID3D12GraphicsCommandList* cmdlist;
+    ID3D12DescriptorHeap* heap;
+    uint32 heapsize;
+};
+internal_func void texture_batch_on_loaded(uint32 index, const char* full_path, const uint8* data, uint64 num_bytes, void* user_data) {
+    texture_batch* batch = (texture_batch*)user_data;
+    if (!data) {
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not open .dds texture '%s'!", full_path);
+        return;
+    }
+
+    texture_load_target* target = &batch->targets[index];
+    batch->upload_buffers[index] = CreateTextureFromMemory(full_path, data, num_bytes,
+                                                           target->resource, target->texture,
+                                                           batch->cmdlist, batch->heap, batch->heapsize,
+                                                           target->descriptor_index);
+}
+
 
 struct Texture_Storage {
     uint16 num_entries;
@@ -86,8 +131,8 @@ Texture_Handle Create_New_Texture(Texture_Storage* ts) {
     return new_handle;
 }
 
-bool Load_Texture_From_File(Texture_Storage* ts, Texture_Handle handle, wchar_t* filename) {
-    printf("Loading '%ws' into texture %u\n", filename, handle);
+bool Load_Texture_From_File(Texture_Storage* ts, Texture_Handle handle, const char* filename) {
+    printf("Loading '%s' into texture %u\n", filename, handle);
 
     ts->textures[handle].gpu_handle = 1;
     ts->textures[handle].width  = 1024;
@@ -195,6 +240,7 @@ struct DX12State {
         BYTE*                                           upload_cbuffer_PerModel_mapped = nullptr;
 
         uint64                                          FenceValue = 0;
+        int64                                           InputTimestamp = 0; // oldest input this frame saw
 
         Microsoft::WRL::ComPtr<ID3D12Resource>          DynamicVBResource;
         Render_Geometry                                 Dynamic;
@@ -268,11 +314,11 @@ bool init_renderer() {
     // Enable D3D12 debug layer
 #if defined(DEBUG) || defined(_DEBUG)
     if FAILED(D3D12GetDebugInterface(IID_PPV_ARGS(&dx12.DebugController))) {
-        RH_FATAL("Could not get debug interface!");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not get debug interface!");
         return false;
     }
     dx12.DebugController->EnableDebugLayer();
-    RH_INFO("Debug Layer Enabled");
+    RH_INFO_CH(LOG_CHANNEL_RENDERER, "Debug Layer Enabled");
 #endif
 
     // Create DXGI Factory
@@ -284,7 +330,7 @@ bool init_renderer() {
 #endif
 
         if FAILED(CreateDXGIFactory2(createFactoryFlags, IID_PPV_ARGS(&factory))) {
-            RH_FATAL("Failed to create factory...");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to create factory...");
             return false;
         }
     }
@@ -294,14 +340,14 @@ bool init_renderer() {
     uint32 max_idx = 0;
     uint64 max_vram = 0;
     {
-        RH_INFO("------ Display Adapters ------------------------");
+        RH_INFO_CH(LOG_CHANNEL_RENDERER, "------ Display Adapters ------------------------");
 
         uint32 i = 0;
         while (factory->EnumAdapters1(i, &adapter) != DXGI_ERROR_NOT_FOUND) {
             DXGI_ADAPTER_DESC1 desc;
             adapter->GetDesc1(&desc);
 
-            RH_TRACE("Device %d: %ls", i, desc.Description);
+            RH_TRACE_CH(LOG_CHANNEL_RENDERER, "Device %d: %ls", i, desc.Description);
             if (desc.DedicatedVideoMemory > max_vram) {
                 max_vram = desc.DedicatedVideoMemory;
                 max_idx = i;
@@ -312,14 +358,14 @@ bool init_renderer() {
 
         // get the best choice now
         if (factory->EnumAdapters1(max_idx, &adapter) == DXGI_ERROR_NOT_FOUND) {
-            RH_FATAL("could not find the best Device...\n");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "could not find the best Device...\n");
             return false;
         }
 
         // print out description of selected adapter
         DXGI_ADAPTER_DESC desc;
         adapter->GetDesc(&desc);
-        RH_INFO("Chosen Device: '%ls'"
+        RH_INFO_CH(LOG_CHANNEL_RENDERER, "Chosen Device: '%ls'"
         "\n         VideoMemory:  %.1llf GB"
         "\n         SystemMemory: %.1llf GB"
                 , desc.Description, ((double)desc.DedicatedVideoMemory) / (1024.0*1024.0*1024.0));
@@ -332,22 +378,22 @@ bool init_renderer() {
                 if FAILED(D3D12CreateDevice(adapter.Get(), D3D_FEATURE_LEVEL_12_0, IID_PPV_ARGS(&dx12.Device))) {
                     if FAILED(D3D12CreateDevice(adapter.Get(), D3D_FEATURE_LEVEL_11_1, IID_PPV_ARGS(&dx12.Device))) {
                         if FAILED(D3D12CreateDevice(adapter.Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&dx12.Device))) {
-                            RH_FATAL("No feature levels supported, could not create a DX12 Device!");
+                            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "No feature levels supported, could not create a DX12 Device!");
                             return false;
                         } else {
-                            RH_INFO("Created a DX12 Device with Feature Level: 11_0");
+                            RH_INFO_CH(LOG_CHANNEL_RENDERER, "Created a DX12 Device with Feature Level: 11_0");
                         }
                     } else {
-                        RH_INFO("Created a DX12 Device with Feature Level: 11_1");
+                        RH_INFO_CH(LOG_CHANNEL_RENDERER, "Created a DX12 Device with Feature Level: 11_1");
                     }
                 } else {
-                    RH_INFO("Created a DX12 Device with Feature Level: 12_0");
+                    RH_INFO_CH(LOG_CHANNEL_RENDERER, "Created a DX12 Device with Feature Level: 12_0");
                 }
             } else {
-                RH_INFO("Created a DX12 Device with Feature Level: 12_1");
+                RH_INFO_CH(LOG_CHANNEL_RENDERER, "Created a DX12 Device with Feature Level: 12_1");
             }
         } else {
-            RH_INFO("Created a DX12 Device with Feature Level: 12_2");
+            RH_INFO_CH(LOG_CHANNEL_RENDERER, "Created a DX12 Device with Feature Level: 12_2");
         }
 
         static const D3D_FEATURE_LEVEL FEATURE_LEVELS_ARRAY[] =
@@ -370,7 +416,7 @@ bool init_renderer() {
         D3D12_FEATURE_DATA_D3D12_OPTIONS5 opt5 = {};
         dx12.Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &opt5, sizeof(opt5));
         if (opt5.RaytracingTier) {
-            RH_INFO("Feature: Raytracing Tier: %.1f", (real32)opt5.RaytracingTier / 10.0f);
+            RH_INFO_CH(LOG_CHANNEL_RENDERER, "Feature: Raytracing Tier: %.1f", (real32)opt5.RaytracingTier / 10.0f);
         }
 
         // enable debug messages
@@ -408,7 +454,7 @@ bool init_renderer() {
             NewFilter.DenyList.pIDList = DenyIds;
 
             if (FAILED(pInfoQueue->PushStorageFilter(&NewFilter))) {
-                RH_FATAL("Failed to setup info-queue for debug messages");
+                RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to setup info-queue for debug messages");
                 return false;
             }
 
@@ -419,16 +465,16 @@ bool init_renderer() {
             if (SUCCEEDED(pInfoQueue->QueryInterface(IID_PPV_ARGS(&pInfoQueue1)))) {
                 D3D12_MESSAGE_CALLBACK_FLAGS callback_flags = D3D12_MESSAGE_CALLBACK_FLAG_NONE;
                 if SUCCEEDED(pInfoQueue1->RegisterMessageCallback(d3d_debug_msg_callback, callback_flags, NULL, &dx12.callback_cookie)) {
-                    RH_FATAL("Could not register msg callback...");
+                    RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not register msg callback...");
                     return false;
                 }
             } else {
-                RH_FATAL("Could not create info-queue");
+                RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create info-queue");
                 return false;
             }
             */
         } else {
-            RH_FATAL("Could not create info-queue");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create info-queue");
             return false;
         }
 #endif
@@ -443,7 +489,7 @@ bool init_renderer() {
         qual_level.NumQualityLevels = 0;
         dx12.Device->CheckFeatureSupport(D3D12_FEATURE_MULTISAMPLE_QUALITY_LEVELS, &qual_level, sizeof(qual_level));
 
-        RH_INFO("MSAA x4 Quality Level: %u", qual_level.NumQualityLevels);
+        RH_INFO_CH(LOG_CHANNEL_RENDERER, "MSAA x4 Quality Level: %u", qual_level.NumQualityLevels);
     }
 
     // Check for root signature version 1.2
@@ -461,16 +507,16 @@ bool init_renderer() {
                 if (FAILED(dx12.Device->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &sig, sizeof(D3D12_FEATURE_DATA_ROOT_SIGNATURE)))) {
             
                     // 1.0 not valid. This shouldn't happen?
-                    RH_FATAL("Root Signature 1.0 not supported,");
+                    RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Root Signature 1.0 not supported,");
                     return false;
                 } else {
-                    RH_INFO("Feature: Root Signature 1.0");
+                    RH_INFO_CH(LOG_CHANNEL_RENDERER, "Feature: Root Signature 1.0");
                 }
             } else {
-                RH_INFO("Feature: Root Signature 1.1");
+                RH_INFO_CH(LOG_CHANNEL_RENDERER, "Feature: Root Signature 1.1");
             }
         } else {
-            RH_INFO("Feature: Root Signature 1.2");
+            RH_INFO_CH(LOG_CHANNEL_RENDERER, "Feature: Root Signature 1.2");
         }
     }
 
@@ -485,7 +531,7 @@ bool init_renderer() {
         queue_desc.NodeMask = 0;
         
         if (FAILED(dx12.Device->CreateCommandQueue(&queue_desc, IID_PPV_ARGS(&dx12.CommandQueue_Copy)))) {
-            RH_FATAL("Could not create copy queue");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create copy queue");
             return false;
         }
 
@@ -496,7 +542,7 @@ bool init_renderer() {
         queue_desc.NodeMask = 0;
 
         if (FAILED(dx12.Device->CreateCommandQueue(&queue_desc, IID_PPV_ARGS(&dx12.CommandQueue_Direct)))) {
-            RH_FATAL("Could not create direct queue");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create direct queue");
             return false;
         }
     }
@@ -526,19 +572,19 @@ bool init_renderer() {
                   nullptr,
                   nullptr,
                   &swapChain1)) {
-            RH_FATAL("Could not create swap chain");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create swap chain");
             return false;
         }
 
         // Disable the Alt+Enter fullscreen toggle feature. Switching to fullscreen
         // will be handled manually.
         if FAILED(factory->MakeWindowAssociation(window, DXGI_MWA_NO_ALT_ENTER)) {
-            RH_FATAL("Could not disable alt-enter");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not disable alt-enter");
             return false;
         }
 
         if FAILED(swapChain1.As(&dx12.SwapChain)) {
-            RH_FATAL("Could not turn swapchain1 into swapchain4");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not turn swapchain1 into swapchain4");
             return false;
         }
 
@@ -558,7 +604,7 @@ bool init_renderer() {
         desc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
 
         if FAILED(dx12.Device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&dx12.RTV_DescriptorHeap))) {
-            RH_FATAL("Failed making descriptor heap");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed making descriptor heap");
             return false;
         }
     }
@@ -570,7 +616,7 @@ bool init_renderer() {
         desc.NodeMask       = 0;
 
         if FAILED(dx12.Device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&dx12.DSV_DescriptorHeap))) {
-            RH_FATAL("Failed making descriptor heap");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed making descriptor heap");
             return false;
         }
     }
@@ -582,7 +628,7 @@ bool init_renderer() {
         desc.NodeMask       = 0;
 
         if FAILED(dx12.Device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&dx12.CBV_SRV_UAV_DescriptorHeap))) {
-            RH_FATAL("Failed making descriptor heap");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed making descriptor heap");
             return false;
         }
     }
@@ -594,7 +640,7 @@ bool init_renderer() {
         desc.NodeMask       = 0;
 
         if FAILED(dx12.Device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&dx12.Sam_DescriptorHeap))) {
-            RH_FATAL("Failed making descriptor heap");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed making descriptor heap");
             return false;
         }
     }
@@ -607,7 +653,7 @@ bool init_renderer() {
         {
             ComPtr<ID3D12Resource> backBuffer;
             if FAILED(dx12.SwapChain->GetBuffer(i, IID_PPV_ARGS(&backBuffer))) {
-                RH_FATAL("Failed getting backbuffer %d", i);
+                RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed getting backbuffer %d", i);
                 return false;
             }
 
@@ -624,12 +670,12 @@ bool init_renderer() {
     // command allocators - one direct per frame, one total for copy
     for (uint8 n = 0; n < dx12.num_frames_in_flight; n++) {
         if (FAILED(dx12.Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&dx12.frames[n].CommandAllocator)))) {
-            RH_FATAL("Could not create command allocators");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create command allocators");
             return false;
         }
     }
     if (FAILED(dx12.Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&dx12.CommandAllocator_Copy)))) {
-        RH_FATAL("Could not create command allocator");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create command allocator");
         return false;
     }
 
@@ -641,7 +687,7 @@ bool init_renderer() {
                                             dx12.frames[dx12.frame_idx].CommandAllocator.Get(), 
                                             nullptr, 
                                             IID_PPV_ARGS(dx12.CmdList_Direct.GetAddressOf()))) {
-            RH_FATAL("Could not create command list!");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create command list!");
             return false;
         }
         // start it closed, since each update cycle starts with reset, and it needs to be closed.
@@ -653,7 +699,7 @@ bool init_renderer() {
                                                  dx12.CommandAllocator_Copy.Get(), 
                                                  nullptr, 
                                                  IID_PPV_ARGS(dx12.CmdList_Copy.GetAddressOf()))) {
-            RH_FATAL("Could not create command list!");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create command list!");
             return false;
         }
 
@@ -688,7 +734,7 @@ bool init_renderer() {
                                                   D3D12_RESOURCE_STATE_COMMON,
                                                   &clear,
                                                   IID_PPV_ARGS(dx12.DepthStencilBuffer.GetAddressOf())))) {
-            RH_FATAL("Failed to create depth/stencil buffer");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to create depth/stencil buffer");
             return false;
         }
 
@@ -705,7 +751,7 @@ bool init_renderer() {
 
     // create fence
     if FAILED(dx12.Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&dx12.Fence))) {
-        RH_FATAL("Could not create fence!");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create fence!");
         return false;
     }
 
@@ -828,8 +874,8 @@ bool init_renderer() {
                                               D3D_ROOT_SIGNATURE_VERSION_1_0,
                                               serialized_root_sig.GetAddressOf(),
                                               error_blob.GetAddressOf())) {
-            RH_FATAL("Could not serialize root signature");
-            RH_FATAL("DxError: %s", error_blob->GetBufferPointer());
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not serialize root signature");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "DxError: %s", error_blob->GetBufferPointer());
             return false;
         }
 
@@ -837,7 +883,7 @@ bool init_renderer() {
                                                    serialized_root_sig->GetBufferPointer(),
                                                    serialized_root_sig->GetBufferSize(),
                                                    IID_PPV_ARGS(&dx12.RootSignature))) {
-            RH_FATAL("Could not create root signature");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not create root signature");
             return false;
         }
     }
@@ -976,18 +1022,21 @@ bool init_renderer() {
     }
 
     // Define texture for triangles
-    Microsoft::WRL::ComPtr<ID3D12Resource> upload_buffer_Texture_metal = CreateTextureFromFile(L"../Data/metal.dds",
-                                                                                               &dx12.TextureMetalResource,
-                                                                                               &dx12.TextureMetal,
-                                                                                               cmdlist.Get(),
-                                                                                               dx12.CBV_SRV_UAV_DescriptorHeap.Get(),
-                                                                                               dx12.CBV_SRV_UAV_DescriptorSize);
-    Microsoft::WRL::ComPtr<ID3D12Resource> upload_buffer_Texture_chainlink = CreateTextureFromFile(L"../Data/WireFence.dds",
-                                                                                                   &dx12.TextureChainlinkResource,
-                                                                                                   &dx12.TextureChainLink,
-                                                                                                   cmdlist.Get(),
-                                                                                                   dx12.CBV_SRV_UAV_DescriptorHeap.Get(),
-                                                                                                   dx12.CBV_SRV_UAV_DescriptorSize);
+    // both files are read at once, and each is uploaded as soon as it's in memory.
+    // the upload buffers have to live until the command list has run
+    const char* texture_files[] = { "../Data/metal.dds", "../Data/WireFence.dds" };
+    texture_load_target texture_targets[] = {
+        { &dx12.TextureMetalResource,     &dx12.TextureMetal,     next_texture_descriptor++ },
+        { &dx12.TextureChainlinkResource, &dx12.TextureChainLink, next_texture_descriptor++ },
+    };
+    Microsoft::WRL::ComPtr<ID3D12Resource> texture_upload_buffers[_countof(texture_files)];
+    texture_batch textures = {};
+    textures.targets        = texture_targets;
+    textures.upload_buffers = texture_upload_buffers;
+    textures.cmdlist        = cmdlist.Get();
+    textures.heap           = dx12.CBV_SRV_UAV_DescriptorHeap.Get();
+    textures.heapsize       = dx12.CBV_SRV_UAV_DescriptorSize;
+    file_batch_load(texture_files, _countof(texture_files), texture_batch_on_loaded, &textures);
 
     {
         // create sampler
@@ -1039,7 +1088,7 @@ bool init_renderer() {
 
     // Execute the initialization commands.
     if FAILED(cmdlist->Close()) {
-        RH_FATAL("Failed to close command list");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to close command list");
     }
     ID3D12CommandList* cmdsLists[] = { cmdlist.Get() };
     queue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
@@ -1051,9 +1100,9 @@ bool init_renderer() {
         {  NULL,           NULL}
     };
 
-    RH_DEBUG("Shader defines: %d", _countof(shader_defines)-1);
+    RH_DEBUG_CH(LOG_CHANNEL_RENDERER, "Shader defines: %d", _countof(shader_defines)-1);
     for (uint32 n = 0; n < _countof(shader_defines)-1; n++) {
-        RH_DEBUG("  '%s' = '%s'", shader_defines[n].Name, shader_defines[n].Definition);
+        RH_DEBUG_CH(LOG_CHANNEL_RENDERER, "  '%s' = '%s'", shader_defines[n].Name, shader_defines[n].Definition);
     }
 
     // compile shaders
@@ -1069,8 +1118,8 @@ bool init_renderer() {
                                      0,
                                      &vs_bytecode,
                                      &vs_errors)) {
-            RH_FATAL("Failed to compile vertex shader");
-            RH_FATAL("Errors: %s", (char*)vs_errors->GetBufferPointer());
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to compile vertex shader");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Errors: %s", (char*)vs_errors->GetBufferPointer());
             return false;
         }
     }
@@ -1087,8 +1136,8 @@ bool init_renderer() {
                                      0,
                                      &ps_bytecode,
                                      &ps_errors)) {
-            RH_FATAL("Failed to compile pixel shader");
-            RH_FATAL("Errors: %s", (char*)ps_errors->GetBufferPointer());
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to compile pixel shader");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Errors: %s", (char*)ps_errors->GetBufferPointer());
             return false;
         }
     }
@@ -1120,7 +1169,7 @@ bool init_renderer() {
 
         // create the pso
         if FAILED(dx12.Device->CreateGraphicsPipelineState(&pso_standard, IID_PPV_ARGS(&dx12.PSO_Standard))) {
-            RH_FATAL("Failed to create PSO");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to create PSO");
             return false;
         }
 
@@ -1140,7 +1189,7 @@ bool init_renderer() {
         pso_blend.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
 
         if FAILED(dx12.Device->CreateGraphicsPipelineState(&pso_blend, IID_PPV_ARGS(&dx12.PSO_Blend))) {
-            RH_FATAL("Failed to create Blend PSO");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to create Blend PSO");
             return false;
         }
     }
@@ -1155,13 +1204,13 @@ bool init_renderer() {
     // List supported display modes
     IDXGIOutput* output;
     {
-        RH_INFO("------ Output Devices --------------------------");
+        RH_INFO_CH(LOG_CHANNEL_RENDERER, "------ Output Devices --------------------------");
 
         uint32 out_idx = 0;
         while (adapter->EnumOutputs(out_idx, &output) != DXGI_ERROR_NOT_FOUND) {
             DXGI_OUTPUT_DESC desc;
             output->GetDesc(&desc);
-            RH_INFO("Output %d: '%ls'", out_idx, desc.DeviceName);
+            RH_INFO_CH(LOG_CHANNEL_RENDERER, "Output %d: '%ls'", out_idx, desc.DeviceName);
 
 
             uint32 count = 0;
@@ -1176,7 +1225,7 @@ bool init_renderer() {
                 uint32 n = x.RefreshRate.Numerator;
                 uint32 d = x.RefreshRate.Denominator;
 
-                //RH_INFO("  %u x %u @ %u/%u Hz", x.Width, x.Height, n, d);
+                //RH_INFO_CH(LOG_CHANNEL_RENDERER, "  %u x %u @ %u/%u Hz", x.Width, x.Height, n, d);
             }
 
             ++out_idx;
@@ -1234,7 +1283,7 @@ void d3d_debug_msg_callback(D3D12_MESSAGE_CATEGORY Category,
         case D3D12_MESSAGE_CATEGORY_SHADER:                 msg_cat = "DXShader        "; break;
     }
 
-    LogOutput(level, "[%s] MsgId {%u} '%ls'", msg_cat, ID, pDescription);
+    RH_LOG(LOG_CHANNEL_RENDERER, level, "[%s] MsgId {%u} '%ls'", msg_cat, ID, pDescription);
 }
 
 bool renderer_begin_Frame() {
@@ -1273,7 +1322,7 @@ bool renderer_end_Frame() {
     dx12.CmdList_Direct->ResourceBarrier(1, &barrier);
 
     if FAILED(dx12.CmdList_Direct->Close()) {
-        RH_FATAL("Could not close command list.");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not close command list.");
         return false;
     }
 
@@ -1292,8 +1341,10 @@ bool renderer_end_Frame() {
     return true;
 }
 
-bool renderer_draw_frame() {
+bool renderer_draw_frame(int64 input_timestamp) {
     if (renderer_begin_Frame()) {
+        dx12.frames[dx12.frame_idx].InputTimestamp = input_timestamp;
+
         // keep track of time (poorly cx)
         static real32 t = 0.0f;
         t += 1.0f / 60.0f;
@@ -1470,9 +1521,11 @@ bool renderer_draw_frame() {
 bool renderer_present(uint32 sync_interval) {
     const uint32 presentFlags = 0;
     if FAILED(dx12.SwapChain->Present(sync_interval, presentFlags)) {
-        RH_FATAL("Error presenting.");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Error presenting.");
         return false;
     }
+    input_latency_frame_presented(dx12.frames[dx12.frame_idx].InputTimestamp, platform_get_wall_clock());
+    dx12.frames[dx12.frame_idx].InputTimestamp = 0;
 
     // signal fence value
     dx12.frames[dx12.frame_idx].FenceValue = ++dx12.CurrentFence;
@@ -1501,33 +1554,65 @@ inline uint32 Real32AsUint32(real32 v) {
 };
 
 
-Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromFile(const wchar_t* filename, 
+Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromFile(const char* filename, 
                                                              Microsoft::WRL::ComPtr<ID3D12Resource>* tex_resource,
                                                              Renderer_Texture* tex,
                                                              ID3D12GraphicsCommandList* cmdlist,
                                                              ID3D12DescriptorHeap* heap,
                                                              uint32 heapsize) {
+    // the subresources point straight into the mapped file, so there's no copy of it in between
+    mapped_file dds_file;
+    if (!platform_map_file(filename, &dds_file, PLATFORM_MAP_SEQUENTIAL | PLATFORM_MAP_PREFAULT)) {
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not open .dds texture '%s'!", filename);
+        return nullptr;
+    }
+
+    Microsoft::WRL::ComPtr<ID3D12Resource> upload_buffer = CreateTextureFromMemory(filename, dds_file.data, dds_file.num_bytes,
+                                                                                   tex_resource, tex, cmdlist, heap, heapsize,
+                                                                                   next_texture_descriptor++);
+    // UpdateSubresources copied everything into the upload buffer
+    platform_unmap_file(&dds_file);
+    return upload_buffer;
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromMemory(const char* filename,
+                                                               const uint8* dds_data,
+                                                               uint64 dds_size,
+                                                               Microsoft::WRL::ComPtr<ID3D12Resource>* tex_resource,
+                                                               Renderer_Texture* tex,
+                                                               ID3D12GraphicsCommandList* cmdlist,
+                                                               ID3D12DescriptorHeap* heap,
+                                                               uint32 heapsize,
+                                                               uint32 descriptor_index) {
     Microsoft::WRL::ComPtr<ID3D12Device> device;
     cmdlist->GetDevice(IID_PPV_ARGS(&device));
 
     Microsoft::WRL::ComPtr<ID3D12Resource> upload_buffer;
 
-    std::unique_ptr<uint8_t[]> ddsData;
     std::vector<D3D12_SUBRESOURCE_DATA> subresources;
     ID3D12Resource* tex_ptr;
-    DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
-    HRESULT res = DirectX::LoadDDSTextureFromFile(
+    HRESULT res = DirectX::LoadDDSTextureFromMemory(
         device.Get(),
-        filename,/*L"../Data/metal.dds",*/
+        dds_data,
+        (size_t)dds_size,
         &tex_ptr,
-        ddsData,
-        subresources,
-        &format);
+        subresources);
 
     if FAILED(res) {
-        RH_FATAL("Could not load .dds texture!");
-        return false;
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Could not load .dds texture '%s'!", filename);
+        return nullptr;
+    }
+    DXGI_FORMAT format = tex_ptr->GetDesc().Format;
+
+    // name it after its file (LoadDDSTextureFromFile used to), so the debug layer and PIX can tell textures apart
+    uint8 name_memory[2*(MAX_PATH + 2)];
+    memory_arena name_arena;
+    CreateArena(&name_arena, sizeof(name_memory), name_memory);
+    string_view name = make_string_view(filename);
+    if (name.length > MAX_PATH) {
+        name = string_substring(name, name.length - MAX_PATH, MAX_PATH);
     }
+    tex_ptr->SetName(string_utf8_to_utf16(name, &name_arena));
 
     Microsoft::WRL::ComPtr<ID3D12Resource> texture;
     texture.Attach(tex_ptr);
@@ -1564,10 +1649,9 @@ Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromFile(const wchar_t* file
     cmdlist->ResourceBarrier(1, &barrier);
 
     // create SRV descriptors
-    static uint32 texture_id = 0;
-    tex->gpu_handle = texture_id;
+    tex->gpu_handle = descriptor_index;
     CD3DX12_CPU_DESCRIPTOR_HANDLE hdesc(heap->GetCPUDescriptorHandleForHeapStart(),
-                                        texture_id++, heapsize);
+                                        descriptor_index, heapsize);
 
     D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
     desc.Format = format; /*DXGI_FORMAT_BC3_UNORM*/
@@ -1584,7 +1668,7 @@ Microsoft::WRL::ComPtr<ID3D12Resource> CreateTextureFromFile(const wchar_t* file
     return upload_buffer;
 }
 
-Texture_Handle renderer_create_texture(const wchar_t* filename) {
+Texture_Handle renderer_create_texture(const char* filename) {
     Microsoft::WRL::ComPtr<ID3D12Resource> resource;
     Microsoft::WRL::ComPtr<ID3D12Resource> upload_buffer;
     Renderer_Texture texture;
@@ -1608,7 +1692,7 @@ void FlushDirectQueue() {
     // are on the GPU timeline, the new fence point won't be set until the GPU finishes
     // processing all the commands prior to this Signal().
     if FAILED(dx12.CommandQueue_Direct->Signal(dx12.Fence.Get(), dx12.frames[dx12.frame_idx].FenceValue)) {
-        RH_FATAL("Failed to signal");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to signal");
     }
 
     // Wait until the GPU has completed commands up to this fence point.
@@ -1618,7 +1702,7 @@ void FlushDirectQueue() {
 
         // Fire event when GPU hits current fence.  
         if FAILED(dx12.Fence->SetEventOnCompletion(dx12.frames[dx12.frame_idx].FenceValue, eventHandle)) {
-            RH_FATAL("Failed to set event");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to set event");
         }
 
         // Wait until the GPU hits current fence event is fired.
@@ -1636,7 +1720,7 @@ void FlushCopyQueue() {
     // are on the GPU timeline, the new fence point won't be set until the GPU finishes
     // processing all the commands prior to this Signal().
     if FAILED(dx12.CommandQueue_Copy->Signal(dx12.Fence.Get(), dx12.CopyFenceValue)) {
-        RH_FATAL("Failed to signal");
+        RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to signal");
     }
 
     // Wait until the GPU has completed commands up to this fence point.
@@ -1646,11 +1730,13 @@ void FlushCopyQueue() {
 
         // Fire event when GPU hits current fence.  
         if FAILED(dx12.Fence->SetEventOnCompletion(dx12.CopyFenceValue, eventHandle)) {
-            RH_FATAL("Failed to set event");
+            RH_FATAL_CH(LOG_CHANNEL_RENDERER, "Failed to set event");
         }
 
         // Wait until the GPU hits current fence event is fired.
         WaitForSingleObject(eventHandle, INFINITE);
         CloseHandle(eventHandle);
     }
-}
\ No newline at end of file
+}
+
+#endif // RH_PLATFORM_WINDOWS
@@ -6,5 +6,7 @@ bool init_renderer();
 bool create_pipeline();
 void kill_renderer();
 
-bool renderer_draw_frame();
+// input_timestamp: arrival of the oldest input the frame reflects (input_get_pending_timestamp()),
+// reported to the input latency stats once the frame is presented
+bool renderer_draw_frame(int64 input_timestamp);
 bool renderer_present(uint32 sync_interval);
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "Renderer.h"
+
+// Renderer.cpp (DX12) is used on windows
+#ifndef RH_PLATFORM_WINDOWS
+
+#include "Platform/Platform.h"
+#include "Core/Logger.h"
+#include "Core/Input_Latency.h"
+
+/*
+ * Null renderer:
+ *   Draws nothing and presents right away, but otherwise goes through the same frame
+ *   steps, so the engine loop (and its input latency stats) can run headless.
+ * */
+
+struct null_renderer_state {
+    uint64 frame_number;
+    int64 input_timestamp; // oldest input the current frame saw
+};
+global_variable null_renderer_state null_renderer;
+
+bool init_renderer() {
+    null_renderer = {};
+    RH_INFO_CH(LOG_CHANNEL_RENDERER, "Using the null renderer, nothing will be drawn.");
+    return true;
+}
+
+bool create_pipeline() {
+    return true;
+}
+
+void kill_renderer() {
+    RH_INFO_CH(LOG_CHANNEL_RENDERER, "Null renderer presented %llu frames.", null_renderer.frame_number);
+}
+
+bool renderer_draw_frame(int64 input_timestamp) {
+    null_renderer.input_timestamp = input_timestamp;
+    return true;
+}
+
+bool renderer_present(uint32 sync_interval) {
+    input_latency_frame_presented(null_renderer.input_timestamp, platform_get_wall_clock());
+    null_renderer.input_timestamp = 0;
+    null_renderer.frame_number++;
+    return true;
+}
+
+#endif // RH_PLATFORM_WINDOWS
@@ -5,6 +5,7 @@
 #include "Memory/Memory.h"
 #include "Core/Asserts.h"
 #include "Core/Logger.h"
+#include "Core/Logger_File.h"
 
 typedef uint16 Texture_Handle;
 
@@ -109,8 +110,22 @@ int main(int argc, char* argv[]) {
 #include "Platform/Platform.h"
 #include "Core/Application.h"
 #include "Core/Logger.h"
+#include "Core/Logger_File.h"
+#include "Core/Logger_Binary.h"
 #include "Core/Event.h"
+#include "Core/Event_Listeners.h"
+#include "Core/Event_Trace.h"
+#include "Core/File_Batch.h"
+#include "Core/Frame_Pacer.h"
 #include "Core/Input.h"
+#include "Core/Input_Actions.h"
+#include "Core/Input_Record.h"
+#include "Core/Input_Latency.h"
+#include "Core/Job_System.h"
+#include "Core/Job_Benchmark.h"
+#include "Core/String.h"
+#include "Core/String_Builder.h"
+#include "Core/String_Benchmark.h"
 #include "Renderer/Renderer.h"
 
 #include <laml/laml.hpp>
@@ -135,16 +150,33 @@ struct RohinEngine {
     laml::Mat4 projection_matrix;
 
     RohinMemory app_memory;
+
+    // engine-level input actions
+    uint32 action_quit;
+    uint32 action_pause;
+    uint32 action_debug;
 };
 global_variable RohinEngine engine;
 
+// used if ../data/input.cfg can't be loaded
+global_variable const char* default_input_bindings =
+    "action quit  key esc\n"
+    "action pause key p\n"
+    "action debug key F1\n";
+
 bool32 engine_on_event(uint16 code, void* sender, void* listener, event_context context);
-bool32 engine_on_resize(uint16 code, void* sender, void* listener, event_context context);
 
+#if RH_PLATFORM_WINDOWS
 //int main() {
 int WinMain() {
+    int argc = __argc;
+    char** argv = __argv;
+#else
+int main(int argc, char** argv) {
+#endif
     InitLogging(true, log_level::LOG_LEVEL_TRACE);
     platform_setup_paths();
+    log_file_open("rohin.log");
 
     AppConfig config;
     config.application_name = "DX12 Test";
@@ -160,6 +192,18 @@ int WinMain() {
 
     RH_INFO("Rohin Engine v0.0.1");
 
+    // resources load through file batches
+    if (!platform_async_io_init(FILE_BATCH_MAX_IN_FLIGHT)) {
+        RH_FATAL("Failed to start async file reads!");
+        return -1;
+    }
+
+    // one worker per physical core, this thread is worker 0
+    if (!job_system_init(0)) {
+        RH_FATAL("Failed to start the job system!");
+        return -1;
+    }
+
 #if RH_INTERNAL
     uint64 base_address = Terabytes(2);
 #else
@@ -195,12 +239,61 @@ int WinMain() {
 
     // Initialize some systems
     event_init(&engine.engine_arena);
+    // quit and resize are bound statically in Core/Event_Listeners.h
     event_register(EVENT_CODE_APPLICATION_QUIT, 0, engine_on_event);
-    event_register(EVENT_CODE_KEY_PRESSED, 0, engine_on_event);
-    event_register(EVENT_CODE_RESIZED, 0, engine_on_resize);
 
     input_init(&engine.engine_arena);
 
+    // --record-events <file> / --replay-events <file>
+    // --record-input <file>  / --replay-input <file> [--exit-after-replay]
+    // --bench-jobs / --bench-strings: log that benchmark and exit
+    const char* record_events_path = nullptr;
+    const char* record_input_path = nullptr;
+    bool32 exit_after_replay = false;
+    bool32 bench_jobs = false;
+    bool32 bench_strings = false;
+    for (int n = 1; n < argc; n++) {
+        if (string_compare(argv[n], "--exit-after-replay") == 0) {
+            exit_after_replay = true;
+        }
+        if (string_compare(argv[n], "--bench-jobs") == 0) {
+            bench_jobs = true;
+        }
+        if (string_compare(argv[n], "--bench-strings") == 0) {
+            bench_strings = true;
+        }
+        if (n + 1 == argc) {
+            break;
+        }
+        if (string_compare(argv[n], "--record-events") == 0) {
+            record_events_path = argv[n + 1];
+            event_trace_start_recording(Megabytes(16));
+        } else if (string_compare(argv[n], "--replay-events") == 0) {
+            event_trace_start_replay(argv[n + 1]);
+        } else if (string_compare(argv[n], "--record-input") == 0) {
+            record_input_path = argv[n + 1];
+            input_record_start(Megabytes(16));
+        } else if (string_compare(argv[n], "--replay-input") == 0) {
+            input_playback_start(argv[n + 1]);
+        }
+    }
+    exit_after_replay = exit_after_replay && input_playback_is_playing();
+
+    if (bench_jobs) {
+        job_benchmark_run(0);
+    }
+    if (bench_strings) {
+        string_benchmark_run(0);
+    }
+
+    if (!input_actions_load("../data/input.cfg")) {
+        RH_WARN("Using the default input bindings.");
+        input_actions_compile(make_string_view(default_input_bindings));
+    }
+    engine.action_quit  = input_find_action("quit");
+    engine.action_pause = input_find_action("pause");
+    engine.action_debug = input_find_action("debug");
+
     void* memory = platform_alloc(config.requested_memory, base_address);
     if (memory) {
         engine.app_memory.AppStorage      = memory;
@@ -208,12 +301,11 @@ int WinMain() {
         engine.app_memory.GameStorage     = ((uint8*)memory + engine.app_memory.AppStorageSize);
         engine.app_memory.GameStorageSize = Megabytes(4);
 
-        engine.is_running = true;
+        engine.is_running = !bench_jobs && !bench_strings;
 
         ////////////////////////////////////////////////////////////////////////////////////////
         // app startup
 
-        uint64 LastCounter = platform_get_wall_clock();
         uint64 FlipWallClock = platform_get_wall_clock();
         //uint64 LastCycleCount = __rdtsc();
 
@@ -225,49 +317,51 @@ int WinMain() {
         // app initialize
         engine.is_paused = false;
 
+        frame_pacer_init(engine.lock_framerate ? (real32)target_framerate : 0.0f);
+
         // Game Loop!
         RH_INFO("------ Starting Main Loop ----------------------");
         while(engine.is_running) {
+            // scratch memory for this frame
+            ResetArena(&engine.frame_render_arena);
+
             if (!platform_process_messages()) {
                 engine.is_running = false;
             }
+            event_trace_replay_frame();
+            if (exit_after_replay && !input_playback_is_playing()) {
+                engine.is_running = false;
+            }
+            input_playback_frame();
+
+            // fired as events, so an event trace has them and --replay-events does the same
+            if (input_action_pressed(engine.action_quit)) {
+                event_application_quit quit_event = {};
+                event_fire_typed(quit_event);
+            }
+            if (input_action_pressed(engine.action_pause)) {
+                event_action_pressed action_event = { engine.action_pause };
+                event_fire_typed(action_event);
+            }
+            if (input_action_pressed(engine.action_debug)) {
+                event_action_pressed action_event = { engine.action_debug };
+                event_fire_typed(action_event);
+            }
 
             if (!engine.is_paused) {
                 // app update
 
                 // render scene
-                renderer_draw_frame();
+                renderer_draw_frame(input_get_pending_timestamp());
                 renderer_present(1); // note: runs wayyy faster if its here?
+            }
 
-                uint64 WorkCounter = platform_get_wall_clock();
-                real32 WorkSecondsElapsed = (real32)platform_get_seconds_elapsed(LastCounter, WorkCounter);
-
-                // TODO: Untested! buggy
-                real32 SecondsElapsedForFrame = WorkSecondsElapsed;
-                bool32 LockFramerate = false;
-                uint32 num_busy_sleep = 0;
-                if (LockFramerate) {
-                    if (SecondsElapsedForFrame < engine.target_frame_time) {
-                        uint64 SleepMS = (uint64)(1000.0f*(engine.target_frame_time - SecondsElapsedForFrame));
-                        if (SleepMS > 0) {
-                            platform_sleep(SleepMS);
-                        }
-    
-                        while (SecondsElapsedForFrame < engine.target_frame_time) {
-                            SecondsElapsedForFrame = (real32)platform_get_seconds_elapsed(LastCounter, platform_get_wall_clock());
-                            num_busy_sleep++;
-                        }
-                    } else {
-                        // TODO: Missed Frame Rate!
-                        //RH_ERROR("Frame rate missed!");
-                    }
-                }
+            // hold the frame rate, paused or not
+            engine.last_frame_time = frame_pacer_wait();
 
-                uint64 EndCounter = platform_get_wall_clock();
-                engine.last_frame_time = (real32)platform_get_seconds_elapsed(LastCounter, EndCounter);
+            if (!engine.is_paused) {
                 real32 MSPerFrame = (real32)(1000.0f * engine.last_frame_time);
                 //MSLastFrame.addSample(MSPerFrame);
-                LastCounter = EndCounter;
     
                 //Win32DisplayBufferToWindow(DeviceContext, Dimension.Width, Dimension.Height);
                 //platform_swap_buffers();
@@ -282,17 +376,44 @@ int WinMain() {
                 real32 FPS = 1000.0f / MSPerFrame;
                 //real32 MCPF = ((real32)CyclesElapsed / (1000.0f*1000.0f));
     
-                #if 0
-                RH_TRACE("Frame: %.02f ms  %.02ffps\n", MSPerFrame, FPS);
-                #else
-                platform_console_set_title("%s: %.02f ms, FPS: %7.02ffps [%3u]", config.application_name, MSPerFrame, FPS, num_busy_sleep);
-                #endif
-
-                input_update(engine.last_frame_time);
+                RH_TRACE_BIN("Frame: %.02f ms  %.02ffps", MSPerFrame, FPS);
+                string_builder title;
+                string_builder_begin(&title, &engine.frame_render_arena);
+                string_append(&title, config.application_name);
+                string_append(&title, ": ");
+                string_append_float(&title, MSPerFrame, 2);
+                string_append(&title, " ms, FPS: ");
+                string_append_float(&title, FPS, 2);
+                string_append(&title, "fps");
+
+                frame_pacer_stats pacing;
+                frame_pacer_get_recent(&pacing);
+                string_append(&title, " jitter: ");
+                string_append_float(&title, pacing.jitter_ms, 3);
+                string_append(&title, " ms");
+
+                input_latency_stats latency;
+                input_latency_get_recent(&latency);
+                if (latency.num_samples) {
+                    string_append(&title, " input: ");
+                    string_append_float(&title, latency.mean_ms, 2);
+                    string_append(&title, " ms, p99: ");
+                    string_append_float(&title, latency.p99_ms, 2);
+                    string_append(&title, " ms");
+                }
+                platform_console_set_title(string_builder_finish(&title).data);
             }
+
+            // even while paused, so this frame's presses don't carry over
+            input_update(engine.last_frame_time);
+
+            // event payloads only live for one frame
+            event_end_frame();
         }
 
         // app shutdown
+        input_latency_log_report();
+        frame_pacer_log_report();
 
         platform_free(memory);
     } else {
@@ -301,9 +422,19 @@ int WinMain() {
 
     // renderer shutdown
     kill_renderer();
+    platform_async_io_shutdown();
+    job_system_shutdown();
     platform_shutdown();
 
     // shutdown all systems
+    if (record_events_path) {
+        event_trace_stop_recording(record_events_path);
+    }
+    event_trace_stop_replay();
+    if (record_input_path) {
+        input_record_stop(record_input_path);
+    }
+    input_playback_stop();
     input_shutdown();
     event_shutdown();
     ShutdownLogging();
@@ -316,44 +447,45 @@ bool32 engine_on_event(uint16 code, void* sender, void* listener, event_context
         case EVENT_CODE_APPLICATION_QUIT:
             engine.is_running = false;
             return true;
-        case EVENT_CODE_KEY_PRESSED:
-            if (context.u16[0] == KEY_ESCAPE) {
-                event_context no_data = {};
-                event_fire(EVENT_CODE_APPLICATION_QUIT, 0, no_data);
-            } else if (context.u16[0] == KEY_P) {
-                engine.is_paused = !engine.is_paused;
-            } else if (context.u16[0] == KEY_F1) {
-                engine.debug_mode = !engine.debug_mode;
-                RH_INFO("Debug Mode: %s", engine.debug_mode ? "Enabled" : "Disabled");
-            } else {
-                keyboard_keys key = (keyboard_keys)context.u16[0];
-                //RH_INFO("Key Pressed: [%s]", input_get_key_string(key));
-            }
     }
 
-    if ((code != EVENT_CODE_KEY_PRESSED)) {
-        RH_TRACE("Engine[0x%016llX] recieved event code %d \n         "
-                 "Sender=[0x%016llX] \n         "
-                 "Listener=[0x%016llX] \n         "
-                 "Data=[%llu], [%u,%u], [%hu,%hu,%hu,%hu]",
-                 (uintptr_t)(&engine), code, (uintptr_t)sender, (uintptr_t)listener,
-                 context.u64,
-                 context.u32[0], context.u32[1],
-                 context.u16[0], context.u16[1], context.u16[2], context.u16[3]);
-    }
+    RH_TRACE_BIN("Engine[0x%016llX] recieved event code %d \n         "
+             "Sender=[0x%016llX] \n         "
+             "Listener=[0x%016llX] \n         "
+             "Data=[%llu], [%u,%u], [%hu,%hu,%hu,%hu]",
+             (uintptr_t)(&engine), code, (uintptr_t)sender, (uintptr_t)listener,
+             context.u64,
+             context.u32[0], context.u32[1],
+             context.u16[0], context.u16[1], context.u16[2], context.u16[3]);
+
+    return false;
+}
 
-    //renderer_on_event(code, sender, listener, context);
+bool32 engine_on_quit(const event_application_quit& event) {
+    engine.is_running = false;
+    return true;
+}
 
+bool32 engine_on_action(const event_action_pressed& event) {
+    if (event.action == engine.action_pause) {
+        engine.is_paused = !engine.is_paused;
+        return true;
+    }
+    if (event.action == engine.action_debug) {
+        engine.debug_mode = !engine.debug_mode;
+        RH_INFO("Debug Mode: %s", engine.debug_mode ? "Enabled" : "Disabled");
+        return true;
+    }
     return false;
 }
 
-bool32 engine_on_resize(uint16 code, void* sender, void* listener, event_context context) {
-    real32 width  = (real32)context.u32[0];
-    real32 height = (real32)context.u32[1];
+bool32 engine_on_resized(const event_resized& event) {
+    real32 width  = (real32)event.width;
+    real32 height = (real32)event.height;
     laml::transform::create_projection_perspective(engine.projection_matrix, engine.view_vert_fov, width/height, 0.1f, 100.0f);
 
-    //renderer_resized(context.u32[0], context.u32[1]);
-    //engine.app->on_resize(engine.app, context.u32[0], context.u32[1]);
+    //renderer_resized(event.width, event.height);
+    //engine.app->on_resize(engine.app, event.width, event.height);
 
     return false;
 }